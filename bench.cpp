@@ -0,0 +1,313 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <limits>
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <streambuf>
+#include <ostream>
+#include <numeric>
+#include <string_view>
+
+#include "iterators++.h"
+
+// benchmark suite comparing iterators++ pipelines against equivalent hand-written loops.
+// usage: iterators-bench [max_size] [name_filter]
+// sizes run from 1e3 up to max_size (default 1e9) in powers of 10 - only cases whose name contains name_filter are run.
+
+// prevents the optimizer from discarding (or constant folding through) the given value
+template<typename T>
+inline void do_not_optimize(T &v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : "+r,m"(v) : : "memory");
+#else
+	static volatile T sink; sink = v; v = sink;
+#endif
+}
+
+// a cheap bijective mixing function - gives the mapping stages real (non-foldable) work to do
+inline std::uint64_t mix(std::uint64_t x) noexcept
+{
+	x ^= x >> 31;
+	x *= 0x9e3779b97f4a7c15ull;
+	return x ^ (x >> 29);
+}
+
+// a linear congruential generator step - used as the state update for generator-based cases
+inline std::uint64_t lcg(std::uint64_t x) noexcept { return x * 6364136223846793005ull + 1442695040888963407ull; }
+
+// a single benchmark case - pipeline and raw must compute the same result for the same n
+struct bench_case
+{
+	const char *name;     // name to display (and filter by)
+	std::size_t max_size; // the largest size this case supports (e.g. for cases that need backing memory)
+
+	std::function<std::uint64_t(std::size_t)> pipeline; // the iterators++ version
+	std::function<std::uint64_t(std::size_t)> raw;      // the equivalent hand-written loop
+
+	std::function<void(std::size_t)> setup = {}; // optionally prepares the input for a size outside of the timed runs
+};
+
+// backing storage for the pointer range cases - grown on demand
+const std::uint64_t *bench_data(std::size_t n)
+{
+	static std::vector<std::uint64_t> data;
+	if (data.size() < n)
+	{
+		std::size_t old = data.size();
+		data.resize(n);
+		for (std::size_t i = old; i < n; ++i) data[i] = mix(i);
+	}
+	return data.data();
+}
+
+// backing text for the line range cases - n characters of lines between 0 and 127 characters long, grown on demand
+const std::string &bench_text(std::size_t n)
+{
+	static std::string text;
+	if (text.size() < n)
+	{
+		std::size_t line = 0;
+		while (text.size() < n)
+		{
+			std::size_t len = mix(line++) % 128;
+			text.append(len, 'x');
+			text.push_back('\n');
+		}
+	}
+	return text;
+}
+
+// backing csv text for the field cases - n characters of records with 1 to 8 unquoted numeric fields, grown on demand
+const std::string &bench_csv(std::size_t n)
+{
+	static std::string text;
+	for (std::size_t line = 0; text.size() < n; ++line)
+	{
+		std::uint64_t h = mix(line);
+		for (std::size_t f = 0, count = 1 + h % 8; f < count; ++f)
+		{
+			if (f > 0) text.push_back(',');
+			text += std::to_string(mix(h + f) % 100000);
+		}
+		text.push_back('\n');
+	}
+	return text;
+}
+
+// the first n values of bench_data() (shifted down to at most 7 digits) written out in binary and as whitespace-separated text, cached for the last n
+const std::string &bench_stream(std::size_t n, bool binary)
+{
+	static std::size_t size = 0;
+	static std::string bin, text;
+	if (size != n)
+	{
+		const std::uint64_t *p = bench_data(n);
+		bin.clear();
+		text.clear();
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			std::uint32_t v = (std::uint32_t)(p[i] >> 44);
+			bin.append(reinterpret_cast<const char*>(&v), sizeof(v));
+			text += std::to_string(v);
+			text.push_back(' ');
+		}
+		size = n;
+	}
+	return binary ? bin : text;
+}
+
+// a stream buffer that discards what's written to it but counts the characters - the output cases return the count
+class counting_buf : public std::streambuf
+{
+public:
+	std::uint64_t count = 0;
+
+protected:
+	int_type overflow(int_type c) override { if (!traits_type::eq_int_type(c, traits_type::eof())) ++count; return c; }
+	std::streamsize xsputn(const char *, std::streamsize n) override { count += (std::uint64_t)n; return n; }
+};
+
+std::vector<bench_case> make_cases()
+{
+	std::vector<bench_case> cases;
+	constexpr std::size_t unlimited = std::numeric_limits<std::size_t>::max();
+
+	// accumulate() with no operation is summed in closed form for integral value ranges - passing std::plus keeps this timing the iteration
+	cases.push_back({ "value_range.accumulate(plus)", unlimited,
+		[](std::size_t n) { return make_value_range<std::uint64_t>(0, n).accumulate(std::uint64_t(0), std::plus<>{}); },
+		[](std::size_t n) { std::uint64_t s = 0; for (std::uint64_t i = 0; i < n; ++i) s += i; return s; } });
+
+	cases.push_back({ "value_range.map.accumulate", unlimited,
+		[](std::size_t n) { return make_value_range<std::uint64_t>(0, n).map(mix).accumulate(std::uint64_t(0)); },
+		[](std::size_t n) { std::uint64_t s = 0; for (std::uint64_t i = 0; i < n; ++i) s += mix(i); return s; } });
+
+	cases.push_back({ "value_range.map.map.accumulate", unlimited,
+		[](std::size_t n) { return make_value_range<std::uint64_t>(0, n).map(mix).map([](std::uint64_t v) { return v >> 3; }).accumulate(std::uint64_t(0)); },
+		[](std::size_t n) { std::uint64_t s = 0; for (std::uint64_t i = 0; i < n; ++i) s += mix(i) >> 3; return s; } });
+
+	cases.push_back({ "value_range.map.reduce(par_pool)", unlimited,
+		[](std::size_t n) { return make_value_range<std::uint64_t>(0, n).map(mix).reduce(par_pool, std::uint64_t(0)); },
+		[](std::size_t n) { std::uint64_t s = 0; for (std::uint64_t i = 0; i < n; ++i) s += mix(i); return s; } });
+
+	cases.push_back({ "value_range.map.find", unlimited,
+		[](std::size_t n) { auto r = make_value_range<std::uint64_t>(0, n).map(mix); return (std::uint64_t)(r.find(mix(n)) == r.end()); },
+		[](std::size_t n) { std::uint64_t i = 0, t = mix(n); for (; i < n; ++i) if (mix(i) == t) break; return (std::uint64_t)(i == n); } });
+
+	cases.push_back({ "value_range.map.count_if", unlimited,
+		[](std::size_t n) { return (std::uint64_t)make_value_range<std::uint64_t>(0, n).map(mix).count_if([](std::uint64_t v) { return (v & 1) != 0; }); },
+		[](std::size_t n) { std::uint64_t c = 0; for (std::uint64_t i = 0; i < n; ++i) c += (mix(i) & 1) != 0; return c; } });
+
+	cases.push_back({ "count_range(value_iterator).map.accumulate", unlimited,
+		[](std::size_t n) { return make_count_range(value_iterator<std::uint64_t>(0), n).map(mix).accumulate(std::uint64_t(0)); },
+		[](std::size_t n) { std::uint64_t s = 0; for (std::uint64_t i = 0; i < n; ++i) s += mix(i); return s; } });
+
+	cases.push_back({ "count_range(func_iterator).accumulate", unlimited,
+		[](std::size_t n) { return make_count_range(make_func_iterator([x = std::uint64_t(1)]() mutable { return x = lcg(x); }), n).accumulate(std::uint64_t(0)); },
+		[](std::size_t n) { std::uint64_t s = 0, x = 1; for (std::size_t i = 0; i < n; ++i) s += x = lcg(x); return s; } });
+
+	cases.push_back({ "count_range(func_iterator).count_if", unlimited,
+		[](std::size_t n) { return (std::uint64_t)make_count_range(make_func_iterator([x = std::uint64_t(1)]() mutable { return x = lcg(x); }), n).count_if([](std::uint64_t v) { return (v >> 63) != 0; }); },
+		[](std::size_t n) { std::uint64_t c = 0, x = 1; for (std::size_t i = 0; i < n; ++i) c += ((x = lcg(x)) >> 63) != 0; return c; } });
+
+	cases.push_back({ "count_range(unary_func_iterator).accumulate", unlimited,
+		[](std::size_t n) { return make_count_range(make_unary_func_iterator(std::uint64_t(1), [](std::uint64_t &v) { v = lcg(v); }), n).accumulate(std::uint64_t(0)); },
+		[](std::size_t n) { std::uint64_t s = 0, x = 1; for (std::size_t i = 0; i < n; ++i, x = lcg(x)) s += x; return s; } });
+
+	cases.push_back({ "pointer_range.map.accumulate", 100000000,
+		[](std::size_t n) { auto p = bench_data(n); return make_iterator_range(p, p + n).map([](std::uint64_t v) { return v >> 7; }).accumulate(std::uint64_t(0)); },
+		[](std::size_t n) { auto p = bench_data(n); std::uint64_t s = 0; for (std::size_t i = 0; i < n; ++i) s += p[i] >> 7; return s; } });
+
+	cases.push_back({ "pointer_range.map_blocks.accumulate", 100000000,
+		[](std::size_t n) { auto p = bench_data(n); return make_iterator_range(p, p + n).map_blocks([](std::uint64_t v) { return v >> 7; }).accumulate(std::uint64_t(0)); },
+		[](std::size_t n) { auto p = bench_data(n); std::uint64_t s = 0; for (std::size_t i = 0; i < n; ++i) s += p[i] >> 7; return s; } });
+
+	// the "raw" version here is what filtering looked like before filter(): copy_if into a temporary vector, then iterate that
+	cases.push_back({ "pointer_range.filter.accumulate (vs copy_if)", 100000000,
+		[](std::size_t n) { auto p = bench_data(n); return make_iterator_range(p, p + n).filter([](std::uint64_t v) { return (v & 3) == 0; }).accumulate(std::uint64_t(0)); },
+		[](std::size_t n) { auto p = bench_data(n); std::vector<std::uint64_t> tmp; std::copy_if(p, p + n, std::back_inserter(tmp), [](std::uint64_t v) { return (v & 3) == 0; }); std::uint64_t s = 0; for (std::uint64_t v : tmp) s += v; return s; } });
+
+	// the "raw" version here is plain map(), which maps every position twice under adjacent_find - map_cached() maps each position once
+	cases.push_back({ "value_range.map_cached.adjacent_find (vs map)", unlimited,
+		[](std::size_t n) { auto r = make_value_range<std::uint64_t>(0, n).map_cached([](std::uint64_t v) { return mix(mix(mix(v))); }); return (std::uint64_t)(r.adjacent_find() == r.end()); },
+		[](std::size_t n) { auto r = make_value_range<std::uint64_t>(0, n).map([](std::uint64_t v) { return mix(mix(mix(v))); }); return (std::uint64_t)(r.adjacent_find() == r.end()); } });
+
+	// the "raw" version here is what concatenating looked like before concat(): copy both halves into one vector, then iterate that
+	cases.push_back({ "pointer_range.concat.accumulate (vs copy)", 100000000,
+		[](std::size_t n) { auto p = bench_data(n); return make_iterator_range(p, p + n / 2).concat(make_iterator_range(p + n / 2, p + n)).accumulate(std::uint64_t(0)); },
+		[](std::size_t n) { auto p = bench_data(n); std::vector<std::uint64_t> tmp(p, p + n / 2); tmp.insert(tmp.end(), p + n / 2, p + n); std::uint64_t s = 0; for (std::uint64_t v : tmp) s += v; return s; } });
+
+	// the "raw" version here is the usual way of reading lines - std::getline() from an istringstream over the same text
+	cases.push_back({ "line_range.map.accumulate (vs getline)", 100000000,
+		[](std::size_t n) { return (std::uint64_t)make_line_range(bench_text(n).data(), bench_text(n).data() + n).map([](std::string_view l) { return l.size(); }).accumulate(std::size_t(0)); },
+		[](std::size_t n) { std::istringstream in(bench_text(n).substr(0, n)); std::uint64_t s = 0; for (std::string l; std::getline(in, l); ) s += l.size(); return s; } });
+
+	// the "raw" version here is the usual way of splitting records - std::getline() for the lines, then again on ',' into string temporaries
+	cases.push_back({ "line_range.map(field_splitter) (vs getline)", 100000000,
+		[](std::size_t n) { return (std::uint64_t)make_line_range(bench_csv(n).data(), bench_csv(n).data() + n).map(field_splitter{}).accumulate(std::size_t(0), [](std::size_t a, iterator_range<field_iterator> r) { return a + r.map([](std::string_view f) { return f.size(); }).accumulate(std::size_t(0)); }); },
+		[](std::size_t n)
+		{
+			std::istringstream in(bench_csv(n).substr(0, n));
+			std::uint64_t s = 0;
+			for (std::string l; std::getline(in, l); )
+			{
+				std::istringstream rec(l);
+				for (std::string f; std::getline(rec, f, ','); ) s += f.size();
+			}
+			return s;
+		},
+		[](std::size_t n) { bench_csv(n); } });
+
+	// the "raw" version here reads the same values with std::istream_iterator (one formatted extraction per element) - both include setting up the stream
+	cases.push_back({ "binary_read_range.accumulate (vs istream)", 10000000,
+		[](std::size_t n) { std::istringstream in(bench_stream(n, true)); return make_binary_read_range<std::uint32_t>(in).accumulate(std::uint64_t(0)); },
+		[](std::size_t n) { std::istringstream in(bench_stream(n, false)); return std::accumulate(std::istream_iterator<std::uint32_t>(in), std::istream_iterator<std::uint32_t>(), std::uint64_t(0)); },
+		[](std::size_t n) { bench_stream(n, true); } });
+
+	// the "raw" version here formats the same values with std::ostream_iterator (locale-aware operator<< per element)
+	cases.push_back({ "map.copy(text_output_iterator) (vs ostream)", unlimited,
+		[](std::size_t n) { counting_buf buf; std::ostream out(&buf); make_value_range<std::uint64_t>(0, n).map(mix).copy(text_output_iterator(out, " ")); return buf.count; },
+		[](std::size_t n) { counting_buf buf; std::ostream out(&buf); make_value_range<std::uint64_t>(0, n).map(mix).copy(std::ostream_iterator<std::uint64_t>(out, " ")); return buf.count; } });
+
+	// 32-bit lanes, since baseline x86-64 has no packed 64-bit multiply for the vectorized block loop to use
+	cases.push_back({ "value_range.map.accumulate (u32)", unlimited,
+		[](std::size_t n) { return (std::uint64_t)make_value_range<std::uint32_t>(0, (std::uint32_t)n).map([](std::uint32_t v) { return (v * 2654435761u) ^ (v >> 7); }).accumulate(std::uint32_t(0)); },
+		[](std::size_t n) { std::uint32_t s = 0; for (std::uint32_t i = 0; i < (std::uint32_t)n; ++i) s += (i * 2654435761u) ^ (i >> 7); return (std::uint64_t)s; } });
+
+	cases.push_back({ "value_range.map_blocks.accumulate (u32)", unlimited,
+		[](std::size_t n) { return (std::uint64_t)make_value_range<std::uint32_t>(0, (std::uint32_t)n).map_blocks([](std::uint32_t v) { return (v * 2654435761u) ^ (v >> 7); }).accumulate(std::uint32_t(0)); },
+		[](std::size_t n) { std::uint32_t s = 0; for (std::uint32_t i = 0; i < (std::uint32_t)n; ++i) s += (i * 2654435761u) ^ (i >> 7); return (std::uint64_t)s; } });
+
+	return cases;
+}
+
+// runs f(n) until at least min_seconds have elapsed (and at least once) and returns the best observed ns/element.
+// the result of the last run is stored to result so the caller can check that both versions agree.
+double time_per_element(const std::function<std::uint64_t(std::size_t)> &f, std::size_t n, std::uint64_t &result)
+{
+	constexpr double min_seconds = 0.25;
+
+	double best = std::numeric_limits<double>::infinity();
+	double total = 0;
+
+	do
+	{
+		std::size_t arg = n;
+		do_not_optimize(arg);
+
+		auto start = std::chrono::steady_clock::now();
+		result = f(arg);
+		do_not_optimize(result);
+		auto stop = std::chrono::steady_clock::now();
+
+		double secs = std::chrono::duration<double>(stop - start).count();
+		total += secs;
+		if (secs < best) best = secs;
+	}
+	while (total < min_seconds);
+
+	return best * 1e9 / n;
+}
+
+int main(int argc, const char *const argv[])
+{
+	std::size_t max_size = 1000000000;
+	const char *filter = "";
+
+	if (argc > 1) max_size = (std::size_t)std::strtod(argv[1], nullptr);
+	if (argc > 2) filter = argv[2];
+
+	std::cout << std::left << std::setw(46) << "case" << std::right << std::setw(12) << "n" << std::setw(16) << "pipeline ns/el" << std::setw(16) << "raw ns/el" << std::setw(10) << "ratio" << '\n';
+	std::cout << std::fixed;
+
+	int mismatches = 0;
+	for (const bench_case &c : make_cases())
+	{
+		if (!std::strstr(c.name, filter)) continue;
+
+		for (std::size_t n = 1000; n <= max_size && n <= c.max_size; n *= 10)
+		{
+			if (c.setup) c.setup(n);
+
+			std::uint64_t pipeline_res, raw_res;
+			double pipeline_ns = time_per_element(c.pipeline, n, pipeline_res);
+			double raw_ns = time_per_element(c.raw, n, raw_res);
+
+			std::cout << std::left << std::setw(46) << c.name << std::right << std::setw(12) << n
+				<< std::setprecision(4) << std::setw(16) << pipeline_ns << std::setw(16) << raw_ns
+				<< std::setprecision(2) << std::setw(10) << pipeline_ns / raw_ns;
+			if (pipeline_res != raw_res) { std::cout << "  RESULT MISMATCH"; ++mismatches; }
+			std::cout << std::endl;
+		}
+	}
+
+	return mismatches == 0 ? 0 : 1;
+}
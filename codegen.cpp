@@ -0,0 +1,121 @@
+#include <cstddef>
+#include <cstdint>
+
+#include "iterators++.h"
+
+// codegen parity kernels - each pipeline_<name> is paired with a raw_<name> hand-written loop that computes the same thing the same way
+// (e.g. count_if loops branch on the predicate like the stdlib does) so that any difference in codegen is due to the adaptors.
+// this file is only compiled to an object file (at several optimization levels) and disassembled by codegen_check.cmake,
+// which fails if a pipeline's hot loop has calls, loses vectorization, or grows noticeably larger than its raw counterpart.
+// every kernel is extern "C" so the symbol names in the disassembly match the names here.
+
+extern "C" {
+
+// -- value ranges -- //
+
+// accumulate() with no operation is answered in closed form for integral value ranges, so std::plus is passed to keep the loop
+std::uint32_t pipeline_value_accumulate(std::uint32_t n) { return make_value_range<std::uint32_t>(0, n).accumulate(std::uint32_t(0), std::plus<>{}); }
+std::uint32_t raw_value_accumulate(std::uint32_t n) { std::uint32_t s = 0; for (std::uint32_t i = 0; i < n; ++i) s += i; return s; }
+
+std::uint32_t pipeline_value_map_accumulate(std::uint32_t n) { return make_value_range<std::uint32_t>(0, n).map([](std::uint32_t v) { return v * 3 + 1; }).accumulate(std::uint32_t(0)); }
+std::uint32_t raw_value_map_accumulate(std::uint32_t n) { std::uint32_t s = 0; for (std::uint32_t i = 0; i < n; ++i) s += i * 3 + 1; return s; }
+
+std::ptrdiff_t pipeline_value_map_count_if(std::uint32_t n) { return make_value_range<std::uint32_t>(0, n).map([](std::uint32_t v) { return v * 7; }).count_if([](std::uint32_t v) { return (v & 8) != 0; }); }
+std::ptrdiff_t raw_value_map_count_if(std::uint32_t n) { std::ptrdiff_t c = 0; for (std::uint32_t i = 0; i < n; ++i) if (((i * 7) & 8) != 0) ++c; return c; }
+
+std::uint32_t pipeline_value_block_map_accumulate(std::uint32_t n) { return make_value_range<std::uint32_t>(0, n).map_blocks([](std::uint32_t v) { return v * 3 + 1; }).accumulate(std::uint32_t(0)); }
+std::uint32_t raw_value_block_map_accumulate(std::uint32_t n) { std::uint32_t s = 0; for (std::uint32_t i = 0; i < n; ++i) s += i * 3 + 1; return s; }
+
+// -- count ranges -- //
+
+std::uint32_t pipeline_count_map_accumulate(std::size_t n) { return make_count_range(value_iterator<std::uint32_t>(0), n).map([](std::uint32_t v) { return v * 3 + 1; }).accumulate(std::uint32_t(0)); }
+std::uint32_t raw_count_map_accumulate(std::size_t n) { std::uint32_t s = 0, v = 0; for (std::size_t i = 0; i < n; ++i, ++v) s += v * 3 + 1; return s; }
+
+std::uint32_t pipeline_count_func_accumulate(std::size_t n) { return make_count_range(make_func_iterator([x = std::uint32_t(0)]() mutable { return x += 5; }), n).accumulate(std::uint32_t(0)); }
+std::uint32_t raw_count_func_accumulate(std::size_t n) { std::uint32_t s = 0, x = 0; for (std::size_t i = 0; i < n; ++i) s += x += 5; return s; }
+
+// -- pointer ranges -- //
+
+// the stdlib's own loop shape matters for some algorithms (e.g. find is unrolled over random access iterators),
+// so those raw versions run the same algorithm directly over the pointers with the map folded into the predicate.
+
+std::uint32_t pipeline_pointer_map_accumulate(const std::uint32_t *p, std::size_t n) { return make_iterator_range(p, p + n).map([](std::uint32_t v) { return v * 3 + 1; }).accumulate(std::uint32_t(0)); }
+std::uint32_t raw_pointer_map_accumulate(const std::uint32_t *p, std::size_t n) { std::uint32_t s = 0; for (std::size_t i = 0; i < n; ++i) s += p[i] * 3 + 1; return s; }
+
+std::uint32_t pipeline_pointer_block_map_accumulate(const std::uint32_t *p, std::size_t n) { return make_iterator_range(p, p + n).map_blocks([](std::uint32_t v) { return v * 3 + 1; }).accumulate(std::uint32_t(0)); }
+std::uint32_t raw_pointer_block_map_accumulate(const std::uint32_t *p, std::size_t n) { std::uint32_t s = 0; for (std::size_t i = 0; i < n; ++i) s += p[i] * 3 + 1; return s; }
+
+void pipeline_pointer_block_map_copy(const std::uint32_t *p, std::size_t n, std::uint32_t *dest) { make_iterator_range(p, p + n).map_blocks([](std::uint32_t v) { return v * 3 + 1; }).copy(dest); }
+void raw_pointer_block_map_copy(const std::uint32_t *p, std::size_t n, std::uint32_t *dest) { for (std::size_t i = 0; i < n; ++i) dest[i] = p[i] * 3 + 1; }
+
+std::ptrdiff_t pipeline_pointer_map_count_if(const std::uint32_t *p, std::size_t n) { return make_iterator_range(p, p + n).map([](std::uint32_t v) { return v >> 4; }).count_if([](std::uint32_t v) { return (v & 1) != 0; }); }
+std::ptrdiff_t raw_pointer_map_count_if(const std::uint32_t *p, std::size_t n) { return std::count_if(p, p + n, [](std::uint32_t v) { return ((v >> 4) & 1) != 0; }); }
+
+std::ptrdiff_t pipeline_pointer_map_find(const std::uint32_t *p, std::size_t n, std::uint32_t v) { auto r = make_iterator_range(p, p + n).map([](std::uint32_t x) { return x ^ 0x55; }); return r.find(v) - r.begin(); }
+std::ptrdiff_t raw_pointer_map_find(const std::uint32_t *p, std::size_t n, std::uint32_t v) { return std::find_if(p, p + n, [v](std::uint32_t x) { return (x ^ 0x55) == v; }) - p; }
+
+void pipeline_pointer_map_copy(const std::uint32_t *p, std::size_t n, std::uint32_t *dest) { make_iterator_range(p, p + n).map([](std::uint32_t v) { return v * 3 + 1; }).copy(dest); }
+void raw_pointer_map_copy(const std::uint32_t *p, std::size_t n, std::uint32_t *dest) { for (std::size_t i = 0; i < n; ++i) dest[i] = p[i] * 3 + 1; }
+
+// -- zipped pointer ranges (struct of arrays) -- //
+
+void pipeline_pointer_zip_for_each(const std::uint32_t *a, const std::uint32_t *b, std::uint32_t *c, std::size_t n)
+{
+	make_iterator_range(a, a + n).zip(make_iterator_range(b, b + n), make_iterator_range(c, c + n)).for_each([](auto t) { std::get<2>(t) = std::get<0>(t) * 3 + std::get<1>(t); });
+}
+void raw_pointer_zip_for_each(const std::uint32_t *a, const std::uint32_t *b, std::uint32_t *c, std::size_t n) { for (std::size_t i = 0; i < n; ++i) c[i] = a[i] * 3 + b[i]; }
+
+std::uint32_t pipeline_pointer_zip_map_accumulate(const std::uint32_t *a, const std::uint32_t *b, std::size_t n)
+{
+	return make_iterator_range(a, a + n).zip(make_iterator_range(b, b + n)).map([](auto t) { return std::get<0>(t) * std::get<1>(t); }).accumulate(std::uint32_t(0));
+}
+std::uint32_t raw_pointer_zip_map_accumulate(const std::uint32_t *a, const std::uint32_t *b, std::size_t n) { std::uint32_t s = 0; for (std::size_t i = 0; i < n; ++i) s += a[i] * b[i]; return s; }
+
+// -- enumerated pointer ranges -- //
+
+std::uint64_t pipeline_pointer_enumerate_accumulate(const std::uint32_t *p, std::size_t n)
+{
+	return make_iterator_range(p, p + n).enumerate().map([](auto e) { return (std::uint64_t)e.first * e.second; }).accumulate(std::uint64_t(0));
+}
+std::uint64_t raw_pointer_enumerate_accumulate(const std::uint32_t *p, std::size_t n) { std::uint64_t s = 0; for (std::size_t i = 0; i < n; ++i) s += (std::uint64_t)i * p[i]; return s; }
+
+// -- chunked pointer ranges -- //
+
+std::uint32_t pipeline_pointer_chunk_accumulate(const std::uint32_t *p, std::size_t n)
+{
+	std::uint32_t s = 0;
+	for (auto c : make_iterator_range(p, p + n).chunk(64)) s += c.accumulate(std::uint32_t(0));
+	return s;
+}
+std::uint32_t raw_pointer_chunk_accumulate(const std::uint32_t *p, std::size_t n)
+{
+	std::uint32_t s = 0;
+	for (std::size_t i = 0; i < n; i += 64) { std::uint32_t t = 0; for (std::size_t j = i, e = n - i < 64 ? n : i + 64; j < e; ++j) t += p[j]; s += t; }
+	return s;
+}
+
+// -- concatenated pointer ranges -- //
+
+std::uint32_t pipeline_pointer_concat_accumulate(const std::uint32_t *a, std::size_t n, const std::uint32_t *b, std::size_t m)
+{
+	return make_iterator_range(a, a + n).concat(make_iterator_range(b, b + m)).accumulate(std::uint32_t(0));
+}
+std::uint32_t raw_pointer_concat_accumulate(const std::uint32_t *a, std::size_t n, const std::uint32_t *b, std::size_t m)
+{
+	std::uint32_t s = 0;
+	for (std::size_t i = 0; i < n; ++i) s += a[i];
+	for (std::size_t i = 0; i < m; ++i) s += b[i];
+	return s;
+}
+
+std::ptrdiff_t pipeline_pointer_concat_count_if(const std::uint32_t *a, std::size_t n, const std::uint32_t *b, std::size_t m)
+{
+	return make_iterator_range(a, a + n).concat(make_iterator_range(b, b + m)).count_if([](std::uint32_t v) { return (v & 1) != 0; });
+}
+std::ptrdiff_t raw_pointer_concat_count_if(const std::uint32_t *a, std::size_t n, const std::uint32_t *b, std::size_t m)
+{
+	auto odd = [](std::uint32_t v) { return (v & 1) != 0; };
+	return std::count_if(a, a + n, odd) + std::count_if(b, b + m, odd);
+}
+
+}
@@ -0,0 +1,249 @@
+# codegen parity check - run as: cmake -DOBJDUMP=<objdump> -DOBJECT=<codegen object file> -P codegen_check.cmake
+# disassembles the codegen.cpp kernels and compares each pipeline_<name> against its raw_<name> counterpart.
+# the hot loop of a function is taken to be every instruction covered by a backward branch within that function.
+# a pipeline fails if it has more calls than the raw version, if the raw hot loop is vectorized but the pipeline's loop isn't,
+# or if the pipeline's hot loop is more than 25% (+2 instructions of slack) larger than the raw hot loop.
+# KNOWN_GAPS may optionally hold a comma-separated list of kernel names whose failures are only reported, not fatal.
+# BLOCK_KERNELS may optionally hold a comma-separated list of kernel names whose pipeline handles a whole block per loop iteration (see map_blocks).
+# instead of the size check, their block loop (the loop with the most simd instructions) must be vectorized and free of calls
+# (calls elsewhere, e.g. memcpy for the last partial block, are fine).
+# SEGMENT_KERNELS may optionally hold a comma-separated list of kernel names whose pipeline runs an inner loop per segment (see concat).
+# the outer loop over segments would count towards the hot loop, so their size check uses the largest innermost loop of each version instead.
+cmake_minimum_required(VERSION 3.13)
+
+if(NOT OBJDUMP OR NOT OBJECT)
+	message(FATAL_ERROR "usage: cmake -DOBJDUMP=<objdump> -DOBJECT=<object file> -P codegen_check.cmake")
+endif()
+
+execute_process(COMMAND "${OBJDUMP}" -d --no-show-raw-insn "${OBJECT}" OUTPUT_VARIABLE asm RESULT_VARIABLE res)
+if(NOT res EQUAL 0)
+	message(FATAL_ERROR "failed to disassemble ${OBJECT}")
+endif()
+
+# brackets and semicolons would confuse cmake's list handling - none of them matter for the analysis
+string(REPLACE ";" "" asm "${asm}")
+string(REPLACE "[" "" asm "${asm}")
+string(REPLACE "]" "" asm "${asm}")
+string(REPLACE "\n" ";" lines "${asm}")
+
+# -- collect instructions -- #
+
+# for each function we record parallel lists of addresses and instruction kinds:
+# c (call), v (packed simd), j<hex target> (jump), o (other)
+set(funcs "")
+set(func "")
+foreach(line IN LISTS lines)
+	if(line MATCHES "^[0-9a-f]+ <([A-Za-z0-9_]+)>:$")
+		set(func "${CMAKE_MATCH_1}")
+		list(APPEND funcs "${func}")
+		set(${func}_addrs "")
+		set(${func}_kinds "")
+	elseif(func AND line MATCHES "^ *([0-9a-f]+):\t([a-z][a-z0-9.]*)(.*)$")
+		set(addr "${CMAKE_MATCH_1}")
+		set(mnemonic "${CMAKE_MATCH_2}")
+		set(operands "${CMAKE_MATCH_3}")
+
+		if(mnemonic MATCHES "^call")
+			set(kind "c")
+		elseif(mnemonic MATCHES "^j" AND operands MATCHES "^ +([0-9a-f]+) <")
+			set(kind "j${CMAKE_MATCH_1}")
+		elseif(operands MATCHES "%[xyz]mm" AND
+			(mnemonic MATCHES "^v?p(add|sub|mul|cmp|and|or|sll|srl|sra|shuf|max|min|blend|unpck|madd|sad)" OR
+			 mnemonic MATCHES "^v?(add|sub|mul|div|min|max|cmp|and|or|shuf|blend)p[sd]$"))
+			set(kind "v")
+		else()
+			set(kind "o")
+		endif()
+
+		list(APPEND ${func}_addrs "${addr}")
+		list(APPEND ${func}_kinds "${kind}")
+	endif()
+endforeach()
+
+# -- analysis -- #
+
+# computes <func>_calls, <func>_loop (hot loop instruction count), <func>_vec (hot loop simd instruction count),
+# <func>_block_vec / <func>_block_calls (simd instructions and calls in the single loop with the most simd instructions),
+# and <func>_inner (instruction count of the largest loop that contains no other loop)
+function(analyze func)
+	set(addrs ${${func}_addrs})
+	set(kinds ${${func}_kinds})
+	list(LENGTH addrs count)
+	math(EXPR last "${count} - 1")
+
+	# gather the [target, branch] ranges of all backward branches
+	set(loop_begins "")
+	set(loop_ends "")
+	set(calls 0)
+	foreach(i RANGE ${last})
+		list(GET addrs ${i} addr)
+		list(GET kinds ${i} kind)
+		math(EXPR addr "0x${addr}")
+		if(kind STREQUAL "c")
+			math(EXPR calls "${calls} + 1")
+		elseif(kind MATCHES "^j(.*)$")
+			math(EXPR target "0x${CMAKE_MATCH_1}")
+			if(target LESS_EQUAL addr)
+				list(APPEND loop_begins ${target})
+				list(APPEND loop_ends ${addr})
+			endif()
+		endif()
+	endforeach()
+
+	set(loop 0)
+	set(vec 0)
+	list(LENGTH loop_begins loop_count)
+	if(loop_count GREATER 0)
+		math(EXPR loop_last "${loop_count} - 1")
+		foreach(i RANGE ${last})
+			list(GET addrs ${i} addr)
+			list(GET kinds ${i} kind)
+			math(EXPR addr "0x${addr}")
+			foreach(k RANGE ${loop_last})
+				list(GET loop_begins ${k} b)
+				list(GET loop_ends ${k} e)
+				if(addr GREATER_EQUAL b AND addr LESS_EQUAL e)
+					math(EXPR loop "${loop} + 1")
+					if(kind STREQUAL "v")
+						math(EXPR vec "${vec} + 1")
+					endif()
+					break()
+				endif()
+			endforeach()
+		endforeach()
+	endif()
+
+	set(block_vec 0)
+	set(block_calls 0)
+	if(loop_count GREATER 0)
+		foreach(k RANGE ${loop_last})
+			list(GET loop_begins ${k} b)
+			list(GET loop_ends ${k} e)
+			set(k_vec 0)
+			set(k_calls 0)
+			foreach(i RANGE ${last})
+				list(GET addrs ${i} addr)
+				list(GET kinds ${i} kind)
+				math(EXPR addr "0x${addr}")
+				if(addr GREATER_EQUAL b AND addr LESS_EQUAL e)
+					if(kind STREQUAL "v")
+						math(EXPR k_vec "${k_vec} + 1")
+					elseif(kind STREQUAL "c")
+						math(EXPR k_calls "${k_calls} + 1")
+					endif()
+				endif()
+			endforeach()
+			if(k_vec GREATER block_vec)
+				set(block_vec ${k_vec})
+				set(block_calls ${k_calls})
+			endif()
+		endforeach()
+	endif()
+
+	set(inner 0)
+	if(loop_count GREATER 0)
+		foreach(k RANGE ${loop_last})
+			list(GET loop_begins ${k} b)
+			list(GET loop_ends ${k} e)
+			set(nested FALSE)
+			foreach(j RANGE ${loop_last})
+				list(GET loop_begins ${j} b2)
+				list(GET loop_ends ${j} e2)
+				if(b2 GREATER_EQUAL b AND e2 LESS_EQUAL e AND (b2 GREATER b OR e2 LESS e))
+					set(nested TRUE)
+					break()
+				endif()
+			endforeach()
+			if(NOT nested)
+				set(k_size 0)
+				foreach(addr IN LISTS addrs)
+					math(EXPR addr "0x${addr}")
+					if(addr GREATER_EQUAL b AND addr LESS_EQUAL e)
+						math(EXPR k_size "${k_size} + 1")
+					endif()
+				endforeach()
+				if(k_size GREATER inner)
+					set(inner ${k_size})
+				endif()
+			endif()
+		endforeach()
+	endif()
+
+	set(${func}_calls ${calls} PARENT_SCOPE)
+	set(${func}_loop ${loop} PARENT_SCOPE)
+	set(${func}_vec ${vec} PARENT_SCOPE)
+	set(${func}_block_vec ${block_vec} PARENT_SCOPE)
+	set(${func}_block_calls ${block_calls} PARENT_SCOPE)
+	set(${func}_inner ${inner} PARENT_SCOPE)
+endfunction()
+
+# -- comparison -- #
+
+string(REPLACE "," ";" known_gaps "${KNOWN_GAPS}")
+string(REPLACE "," ";" block_kernels "${BLOCK_KERNELS}")
+string(REPLACE "," ";" segment_kernels "${SEGMENT_KERNELS}")
+
+set(failures "")
+set(checked 0)
+foreach(func IN LISTS funcs)
+	if(NOT func MATCHES "^pipeline_(.*)$")
+		continue()
+	endif()
+	set(name "${CMAKE_MATCH_1}")
+	set(raw "raw_${name}")
+	if(NOT "${raw}" IN_LIST funcs)
+		list(APPEND failures "${name}: no ${raw} counterpart")
+		continue()
+	endif()
+
+	analyze(${func})
+	analyze(${raw})
+	math(EXPR checked "${checked} + 1")
+
+	message(STATUS "${name}: hot loop ${${func}_loop} vs ${${raw}_loop} insns, simd ${${func}_vec} vs ${${raw}_vec}, calls ${${func}_calls} vs ${${raw}_calls}")
+
+	set(problems "")
+	math(EXPR limit "${${raw}_loop} * 5 / 4 + 2")
+	if(name IN_LIST block_kernels)
+		if(${func}_block_vec EQUAL 0)
+			list(APPEND problems "${name}: block pipeline loop is not vectorized")
+		elseif(${func}_block_calls GREATER 0)
+			list(APPEND problems "${name}: block pipeline loop makes calls")
+		endif()
+	else()
+		if(${func}_calls GREATER ${raw}_calls)
+			list(APPEND problems "${name}: pipeline makes calls (adaptor not inlined)")
+		endif()
+		if(${raw}_vec GREATER 0 AND ${func}_vec EQUAL 0)
+			list(APPEND problems "${name}: raw loop is vectorized but the pipeline is not")
+		endif()
+		if(name IN_LIST segment_kernels)
+			math(EXPR inner_limit "${${raw}_inner} * 5 / 4 + 2")
+			if(${func}_inner GREATER inner_limit)
+				list(APPEND problems "${name}: pipeline segment loop is ${${func}_inner} instructions (raw is ${${raw}_inner})")
+			endif()
+		elseif(${func}_loop GREATER limit)
+			list(APPEND problems "${name}: pipeline hot loop is ${${func}_loop} instructions (raw is ${${raw}_loop})")
+		endif()
+	endif()
+
+	if(name IN_LIST known_gaps)
+		if(problems)
+			foreach(problem IN LISTS problems)
+				message(STATUS "  known gap - ${problem}")
+			endforeach()
+		else()
+			message(STATUS "  ${name} is listed as a known gap but now passes - it can be removed from the list")
+		endif()
+	else()
+		list(APPEND failures ${problems})
+	endif()
+endforeach()
+
+if(checked EQUAL 0)
+	message(FATAL_ERROR "no pipeline_ kernels found in ${OBJECT}")
+endif()
+if(failures)
+	string(REPLACE ";" "\n  " failures "${failures}")
+	message(FATAL_ERROR "codegen parity failures:\n  ${failures}")
+endif()
@@ -3,6 +3,7 @@
 
 #include <cstdlib>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <utility>
 #include <memory>
@@ -10,6 +11,30 @@
 #include <iterator>
 #include <numeric>
 #include <algorithm>
+#include <functional>
+#include <vector>
+#include <array>
+#include <tuple>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <charconv>
+#include <system_error>
+
+// memory-mapped files (see mmap_range) need posix
+#if defined(__unix__) || defined(__APPLE__)
+#define DRAGAZO_ITERATORS_PLUS_PLUS_POSIX 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 // an iterator traits helper specifically for the requirements of value_iterator.
 // this helper decides on all the compile-time iterator traits to use and value_iterator aliases them and performs sfinae logic to provide the correct interface.
@@ -39,7 +64,7 @@ public: // -- fancy types -- //
 
 	// the difference type to use for random access operators.
 	// this defaults to std::ptrdiff_t unless a more reasonable type can be deduced.
-	typedef typename decltype(__diff_type(nullptr)) difference_type;
+	typedef decltype(__diff_type(nullptr)) difference_type;
 
 	// the iterator category type denoting the capabilities of a value iterator for type T.
 	// this is potentially random access if T supports it, otherwise bidirectional if a -- (prefix) operator exists, otherwise forward only.
@@ -167,53 +192,98 @@ public: // -- comparison -- //
 	constexpr friend bool operator!=(const value_iterator &a, const value_iterator &b) noexcept(noexcept(a.data == b.data)) { return !(a.data == b.data); }
 };
 
-// given a function-like object (including function pointers) creates an assignable function wrapper.
-// this wrapper ensures the function-like object F is assignable.
-template<typename F>
-class assignable_func
+// true if the iterator range [IterBegin, IterEnd) is a value range over an integral type (at most 64 bits) - i.e. an arithmetic sequence of integers.
+// iterator_range answers many algorithms over these in constant time (see iterator_range).
+template<typename IterBegin, typename IterEnd>
+struct is_integral_value_range : std::false_type {};
+template<typename T>
+struct is_integral_value_range<value_iterator<T>, value_iterator<T>>
+	: std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= sizeof(std::uint64_t)> {};
+
+// storage for the function object of an assignable_func.
+// empty (non-final) class types are stored as a base class rather than a member so that they take no space (empty base optimization).
+template<typename F, bool = std::is_class<F>::value && std::is_empty<F>::value && !std::is_final<F>::value>
+class assignable_func_storage
 {
 private: // -- data -- //
 
 	F func; // the stored function
 
+protected: // -- ctor / access -- //
+
+	constexpr explicit assignable_func_storage(const F &f) : func(f) {}
+	constexpr explicit assignable_func_storage(F &&f) : func(std::move(f)) {}
+
+	// gets the stored function.
+	constexpr F &stored() noexcept { return func; }
+	constexpr const F &stored() const noexcept { return func; }
+};
+template<typename F>
+class assignable_func_storage<F, true> : private F
+{
+protected: // -- ctor / access -- //
+
+	constexpr explicit assignable_func_storage(const F &f) : F(f) {}
+	constexpr explicit assignable_func_storage(F &&f) : F(std::move(f)) {}
+
+	// gets the stored function.
+	constexpr F &stored() noexcept { return *this; }
+	constexpr const F &stored() const noexcept { return *this; }
+};
+
+// given a function-like object (including function pointers) creates an assignable function wrapper.
+// this wrapper ensures the function-like object F is assignable.
+// stateless function objects (e.g. captureless lambdas) take no space - iterators storing one of these derive from it to benefit from this.
+template<typename F>
+class assignable_func : private assignable_func_storage<F>
+{
 private: // -- helpers -- //
 
+	typedef assignable_func_storage<F> storage_t;
+	using storage_t::stored;
+
 	// assigns f as the stored function.
 	constexpr void assign(const F &f)
 	{
-		if constexpr (std::is_copy_assignable<F>::value) func = f;
-		else if (&f != &func) { func.~F(); new (&func) F(f); } // hax: destroy the old function and copy construct a new one
+		if constexpr (std::is_copy_assignable<F>::value) stored() = f;
+		else if (&f != &stored()) { stored().~F(); new (&stored()) F(f); } // hax: destroy the old function and copy construct a new one
 	}
 	constexpr void assign(F &&f)
 	{
-		if constexpr (std::is_move_assignable<F>::value) func = std::move(f);
-		else if (&f != &func) { func.~F(); new (&func) F(std::move(f)); } // hax: destroy the old function and move construct a new one
+		if constexpr (std::is_move_assignable<F>::value) stored() = std::move(f);
+		else if (&f != &stored()) { stored().~F(); new (&stored()) F(std::move(f)); } // hax: destroy the old function and move construct a new one
 	}
 
 public: // -- ctor / dtor / asgn -- //
 
 	// creates a new copy func from the given raw function object type.
-	constexpr assignable_func(const F &f) : func(f) {}
-	constexpr assignable_func(F &&f) : func(std::move(f)) {}
+	constexpr assignable_func(const F &f) : storage_t(f) {}
+	constexpr assignable_func(F &&f) : storage_t(std::move(f)) {}
 
-	constexpr assignable_func(const assignable_func &other) : func(other.func) {}
-	constexpr assignable_func(assignable_func &&other) : func(std::move(other.func)) {}
+	// copying/moving is trivial if it is for F (so e.g. iterators holding a captureless lambda can be passed in registers).
+	constexpr assignable_func(const assignable_func &other) = default;
+	constexpr assignable_func(assignable_func &&other) = default;
 
-	constexpr assignable_func &operator=(const assignable_func &other) { assign(other.func); return *this; }
-	constexpr assignable_func &operator=(assignable_func &&other) { assign(std::move(other.func)); return *this; }
+	constexpr assignable_func &operator=(const assignable_func &other) { assign(other.stored()); return *this; }
+	constexpr assignable_func &operator=(assignable_func &&other) { assign(std::move(other.stored())); return *this; }
 
 public: // -- access -- //
 
 	// calls the function with the specified arguments.
 	template<typename ...Args>
-	constexpr decltype(auto) operator()(Args &&...args) { return func(std::forward<Args>(args)...); }
+	constexpr decltype(auto) operator()(Args &&...args) { return stored()(std::forward<Args>(args)...); }
+	template<typename ...Args>
+	constexpr decltype(auto) operator()(Args &&...args) const { return stored()(std::forward<Args>(args)...); }
+
+	// gets the stored function.
+	constexpr const F &get() const noexcept { return stored(); }
 };
 
 // represents an iterator that aliases a function with compatibility signature V() for getting the next value.
 // the stored function may keep an internal state (e.g. stateful lambdas), enabling highly-modular iterator designs.
 // the value type V must define operator ==.
 template<typename F, typename V = decltype(std::declval<F>()())>
-class func_iterator
+class func_iterator : private assignable_func<F>
 {
 public: // -- traits -- //
 
@@ -231,7 +301,7 @@ private: // -- data -- //
 	// V might not be default constructible and we might not have an initial value at ctor time.
 	alignas(V) char _value[sizeof(V)];
 
-	assignable_func<F> func; // the stored function - guarantee assignability
+	// the stored function is held as a (private) assignable_func base so stateless functions take no space.
 
 private: // -- helpers -- //
 
@@ -239,26 +309,30 @@ private: // -- helpers -- //
 	V &value() noexcept { return reinterpret_cast<V&>(_value); }
 	const V &value() const noexcept { return reinterpret_cast<const V&>(_value); }
 
+	// aliases the stored function
+	assignable_func<F> &func() noexcept { return *this; }
+	const assignable_func<F> &func() const noexcept { return *this; }
+
 public: // -- ctor / dtor / asgn -- //
 
 	// constructs a new function iterator from the given function.
 	// the function is called once to get the initial cached value.
-	constexpr explicit func_iterator(const F &f) : func(f) { new (_value) V(func()); }
-	constexpr explicit func_iterator(F &&f) : func(std::move(f)) { new (_value) V(func()); }
+	constexpr explicit func_iterator(const F &f) : assignable_func<F>(f) { new (_value) V(func()()); }
+	constexpr explicit func_iterator(F &&f) : assignable_func<F>(std::move(f)) { new (_value) V(func()()); }
 
 	~func_iterator() { value().~V(); }
 
 	// constructs a new function iterator with a copy of other's stored function and cached value.
-	constexpr func_iterator(const func_iterator &other) : func(other.func) { new (_value) V(other.value()); }
+	constexpr func_iterator(const func_iterator &other) : assignable_func<F>(other.func()) { new (_value) V(other.value()); }
 	// constructs a new function iterator by moving from other's stored function and cached value.
 	// the other iterator is left in an undefined but valid state.
-	constexpr func_iterator(func_iterator &&other) : func(std::move(other.func)) { new (_value) V(std::move(other.value())); }
+	constexpr func_iterator(func_iterator &&other) : assignable_func<F>(std::move(other.func())) { new (_value) V(std::move(other.value())); }
 
 	// copies other's current stored function and cached value to this iterator.
-	constexpr func_iterator &operator=(const func_iterator &other) { value() = other.value(); func = other.func; return *this; }
+	constexpr func_iterator &operator=(const func_iterator &other) { value() = other.value(); func() = other.func(); return *this; }
 	// moves other's current stored function and cached value to this iterator.
 	// the other iterator is left in an undefined but valid state.
-	constexpr func_iterator &operator=(func_iterator &&other) { value() = std::move(other.value()); func = std::move(other.func); return *this; }
+	constexpr func_iterator &operator=(func_iterator &&other) { value() = std::move(other.value()); func() = std::move(other.func()); return *this; }
 
 public: // -- value access -- //
 
@@ -273,8 +347,8 @@ public: // -- value access -- //
 public: // -- inc -- //
 
 	// calls the stored function to get the next value and stores it to the cached
-	constexpr func_iterator &operator++() { value() = func(); return *this; }
-	constexpr func_iterator operator++(int) { func_iterator cpy(*this); value() = func(); return cpy; }
+	constexpr func_iterator &operator++() { value() = func()(); return *this; }
+	constexpr func_iterator operator++(int) { func_iterator cpy(*this); value() = func()(); return cpy; }
 
 public: // -- comparison -- //
 
@@ -283,10 +357,203 @@ public: // -- comparison -- //
 	constexpr friend bool operator!=(const func_iterator &a, const func_iterator &b) { return !(a.value() == b.value()); }
 };
 
+// represents a function iterator (see func_iterator) that doesn't call the stored function until a value is actually needed.
+// constructing, copying, or incrementing never calls the function - dereferencing first calls it once for each position
+// that was skipped over (so stateful functions stay in sync) and then once more to get the value, which is then cached.
+// this is useful for expensive functions (e.g. i/o, parsing) when iterators may be created only as an end marker or discarded unread.
+// comparison compares the values (and so evaluates them) - use make_count_range() for end markers that never evaluate anything.
+template<typename F, typename V = decltype(std::declval<F>()())>
+class lazy_func_iterator
+{
+public: // -- traits -- //
+
+	typedef std::forward_iterator_tag iterator_category;
+	typedef std::ptrdiff_t difference_type;
+
+	typedef V value_type;
+
+	typedef V *pointer;
+	typedef V &reference;
+
+private: // -- data -- //
+
+	// buffer for the cached value - only holds an object if has_value is true.
+	// everything is mutable since dereferencing (a const operation) is what fills the cache.
+	alignas(V) mutable char _value[sizeof(V)];
+	mutable bool has_value = false;
+
+	mutable std::size_t skipped = 0; // the number of positions advanced past without calling the function
+
+	// the stored function - a member rather than a base (as in func_iterator) since it must be callable from const dereferences
+	mutable assignable_func<F> func;
+
+private: // -- helpers -- //
+
+	// aliases the buffer object
+	V &value() const noexcept { return reinterpret_cast<V&>(_value); }
+
+	// destroys the cached value (if any)
+	void __reset() noexcept { if (has_value) { value().~V(); has_value = false; } }
+
+	// makes sure the cached value exists and returns it
+	const V &__fetch() const
+	{
+		if (!has_value)
+		{
+			for (; skipped > 0; --skipped) (void)func();
+			new (_value) V(func());
+			has_value = true;
+		}
+		return value();
+	}
+
+public: // -- ctor / dtor / asgn -- //
+
+	// constructs a new lazy function iterator from the given function.
+	// the function is not called until the first dereference.
+	constexpr explicit lazy_func_iterator(const F &f) : func(f) {}
+	constexpr explicit lazy_func_iterator(F &&f) : func(std::move(f)) {}
+
+	~lazy_func_iterator() { __reset(); }
+
+	// constructs a new lazy function iterator with a copy of other's stored function and cached value (if any).
+	lazy_func_iterator(const lazy_func_iterator &other) : has_value(other.has_value), skipped(other.skipped), func(other.func) { if (has_value) new (_value) V(other.value()); }
+	// constructs a new lazy function iterator by moving from other's stored function and cached value (if any).
+	// the other iterator is left in an undefined but valid state.
+	lazy_func_iterator(lazy_func_iterator &&other) : has_value(other.has_value), skipped(other.skipped), func(std::move(other.func)) { if (has_value) new (_value) V(std::move(other.value())); }
+
+	// copies other's current stored function and cached value (if any) to this iterator.
+	lazy_func_iterator &operator=(const lazy_func_iterator &other)
+	{
+		if (this == &other) return *this;
+		__reset();
+		if (other.has_value) { new (_value) V(other.value()); has_value = true; }
+		skipped = other.skipped;
+		func = other.func;
+		return *this;
+	}
+	// moves other's current stored function and cached value (if any) to this iterator.
+	// the other iterator is left in an undefined but valid state.
+	lazy_func_iterator &operator=(lazy_func_iterator &&other)
+	{
+		if (this == &other) return *this;
+		__reset();
+		if (other.has_value) { new (_value) V(std::move(other.value())); has_value = true; }
+		skipped = other.skipped;
+		func = std::move(other.func);
+		return *this;
+	}
+
+public: // -- value access -- //
+
+	// returns the cached value - calls the function first if it hasn't been evaluated yet
+	const V &operator*() const& { return __fetch(); }
+	V operator*() && { __fetch(); return std::move(value()); }
+
+	// returns the address of the cached value - calls the function first if it hasn't been evaluated yet
+	const V *operator->() const& { return std::addressof(__fetch()); }
+	V *operator->() && = delete;
+
+public: // -- inc -- //
+
+	// moves to the next value - the function is not called until the next dereference
+	lazy_func_iterator &operator++() noexcept { if (has_value) __reset(); else ++skipped; return *this; }
+	lazy_func_iterator operator++(int) { lazy_func_iterator cpy(*this); ++*this; return cpy; }
+
+public: // -- comparison -- //
+
+	// compares the values (evaluating them if needed)
+	friend bool operator==(const lazy_func_iterator &a, const lazy_func_iterator &b) { return *a == *b; }
+	friend bool operator!=(const lazy_func_iterator &a, const lazy_func_iterator &b) { return !(*a == *b); }
+};
+
+// tag type for selecting the single-pass function iterator (see shared_func_iterator) in make_func_iterator().
+struct single_pass_t { explicit single_pass_t() = default; };
+inline constexpr single_pass_t single_pass{};
+
+// represents a single-pass (input iterator) version of func_iterator.
+// all copies share a single stored function and cached value by reference, so copying never copies the function's state.
+// this is useful for functions whose state is large or not meaningfully copyable (e.g. buffers, file handles).
+// as with any input iterator, incrementing one copy advances all of them.
+template<typename F, typename V = decltype(std::declval<F>()())>
+class shared_func_iterator
+{
+public: // -- traits -- //
+
+	typedef std::input_iterator_tag iterator_category;
+	typedef std::ptrdiff_t difference_type;
+
+	typedef V value_type;
+
+	typedef const V *pointer;
+	typedef const V &reference;
+
+private: // -- types -- //
+
+	// the state shared by all copies of an iterator
+	struct state_t
+	{
+		F func;  // the stored function
+		V value; // the cached value
+
+		// the function is called once to get the initial cached value
+		explicit state_t(const F &f) : func(f), value(func()) {}
+		explicit state_t(F &&f) : func(std::move(f)), value(func()) {}
+	};
+
+	// holds a value from before an increment (for *it++)
+	class postfix_value
+	{
+	private: // -- data -- //
+
+		V value; // the held value
+
+	public: // -- ctor / dtor / asgn -- //
+
+		explicit postfix_value(const V &v) : value(v) {}
+
+	public: // -- value access -- //
+
+		// returns the held value
+		const V &operator*() const noexcept { return value; }
+	};
+
+private: // -- data -- //
+
+	std::shared_ptr<state_t> state; // the shared state
+
+public: // -- ctor / dtor / asgn -- //
+
+	// constructs a new shared function iterator from the given function.
+	// the function is called once to get the initial cached value.
+	explicit shared_func_iterator(const F &f) : state(std::make_shared<state_t>(f)) {}
+	explicit shared_func_iterator(F &&f) : state(std::make_shared<state_t>(std::move(f))) {}
+
+public: // -- value access -- //
+
+	// returns the cached value
+	const V &operator*() const noexcept { return state->value; }
+
+	// returns the address of the cached value.
+	const V *operator->() const noexcept { return std::addressof(state->value); }
+
+public: // -- inc -- //
+
+	// calls the stored function to get the next value and stores it to the cached (this is visible through every copy)
+	shared_func_iterator &operator++() { state->value = state->func(); return *this; }
+	postfix_value operator++(int) { postfix_value cpy(state->value); ++*this; return cpy; }
+
+public: // -- comparison -- //
+
+	// compares the cached values
+	friend bool operator==(const shared_func_iterator &a, const shared_func_iterator &b) { return a.state->value == b.state->value; }
+	friend bool operator!=(const shared_func_iterator &a, const shared_func_iterator &b) { return !(a.state->value == b.state->value); }
+};
+
 // represents an iterator that aliases a function with compatibility signature void(V&) for getting the next value.
 // the stored function may keep an internal state (e.g. stateful lambdas), enabling highly-modular iterator designs.
 template<typename V, typename F>
-class unary_func_iterator
+class unary_func_iterator : private assignable_func<F>
 {
 public: // -- traits -- //
 
@@ -300,26 +567,33 @@ public: // -- traits -- //
 
 private: // -- data -- //
 
-	V                  value; // the cached value
-	assignable_func<F> func;  // the stored function
+	V value; // the cached value
+
+	// the stored function is held as a (private) assignable_func base so stateless functions take no space.
+
+private: // -- helpers -- //
+
+	// aliases the stored function
+	assignable_func<F> &func() noexcept { return *this; }
+	const assignable_func<F> &func() const noexcept { return *this; }
 
 public: // -- ctor / dtor / asgn -- //
 
 	// constructs a new function iterator from the given initial value and function object.
 	template<typename _V, typename _F>
-	constexpr unary_func_iterator(_V &&init_value, _F &&f) : value(std::forward<_V>(init_value)), func(std::forward<_F>(f)) {}
+	constexpr unary_func_iterator(_V &&init_value, _F &&f) : assignable_func<F>(std::forward<_F>(f)), value(std::forward<_V>(init_value)) {}
 
 	// constructs a new function iterator with a copy of other's stored function and cached value.
-	constexpr unary_func_iterator(const unary_func_iterator &other) : value(other.value), func(other.func) {}
+	constexpr unary_func_iterator(const unary_func_iterator &other) = default;
 	// constructs a new function iterator by moving from other's stored function and cached value.
 	// the other iterator is left in an undefined but valid state.
-	constexpr unary_func_iterator(unary_func_iterator &&other) : value(std::move(other.value)), func(std::move(other.func)) {}
+	constexpr unary_func_iterator(unary_func_iterator &&other) = default;
 
 	// copies other's current stored function and cached value to this iterator.
-	constexpr unary_func_iterator &operator=(const unary_func_iterator &other) { value = other.value; func = other.func; return *this; }
+	constexpr unary_func_iterator &operator=(const unary_func_iterator &other) { value = other.value; func() = other.func(); return *this; }
 	// moves other's current stored function and cached value to this iterator.
 	// the other iterator is left in an undefined but valid state.
-	constexpr unary_func_iterator &operator=(unary_func_iterator &&other) { value = std::move(other.value); func = std::move(other.func); return *this; }
+	constexpr unary_func_iterator &operator=(unary_func_iterator &&other) { value = std::move(other.value); func() = std::move(other.func()); return *this; }
 
 public: // -- value access -- //
 
@@ -334,8 +608,8 @@ public: // -- value access -- //
 public: // -- inc -- //
 
 	// calls the stored function to get the next value and stores it to the cached
-	constexpr unary_func_iterator &operator++() { func(value); return *this; }
-	constexpr unary_func_iterator operator++(int) { unary_func_iterator cpy(*this); func(value); return cpy; }
+	constexpr unary_func_iterator &operator++() { func()(value); return *this; }
+	constexpr unary_func_iterator operator++(int) { unary_func_iterator cpy(*this); func()(value); return cpy; }
 
 public: // -- comparison -- //
 
@@ -348,6 +622,14 @@ public: // -- comparison -- //
 template<typename F, typename V = decltype(std::declval<F>()())>
 auto make_func_iterator(F &&func) { return func_iterator<std::decay_t<F>, V>(std::forward<F>(func)); }
 
+// takes a function object and returns a single-pass function iterator for it whose copies share the function's state (see shared_func_iterator).
+template<typename F, typename V = decltype(std::declval<F>()())>
+auto make_func_iterator(F &&func, single_pass_t) { return shared_func_iterator<std::decay_t<F>, V>(std::forward<F>(func)); }
+
+// takes a function object and returns a lazy function iterator for it (see lazy_func_iterator).
+template<typename F, typename V = decltype(std::declval<F>()())>
+auto make_lazy_func_iterator(F &&func) { return lazy_func_iterator<std::decay_t<F>, V>(std::forward<F>(func)); }
+
 // takes a function object and ctor args for the initial value and constructs a unary function iterator for it.
 template<typename V, typename F>
 auto make_unary_func_iterator(V &&init_value, F &&func) { return unary_func_iterator<std::decay_t<V>, std::decay_t<F>>(std::forward<V>(init_value), std::forward<F>(func)); }
@@ -487,10 +769,112 @@ public: // -- comparison -- //
 template<typename Iter>
 auto make_count_iterator(Iter &&iter, std::make_signed_t<std::size_t> count) { return count_iterator<std::decay_t<Iter>>(std::forward<Iter>(iter), count); }
 
+// trait denoting if T is a sentinel type - i.e. an end marker that is compared against iterators but is not itself an iterator.
+// adaptors (e.g. iterator_range::map) leave sentinel ends as-is rather than wrapping them.
+template<typename T> struct is_sentinel : std::false_type {};
+
+// an end marker for count iterators which only holds the count at which the range ends.
+// unlike using a count iterator as the end, this never holds a copy of the underlying iterator (which could be expensive, e.g. for func_iterator).
+// count iterators (or adaptors wrapping a count iterator, which expose it via get_iter()) compare equal to a count sentinel when their counts are equal.
+class count_sentinel
+{
+public: // -- types -- //
+
+	typedef std::make_signed_t<std::size_t> count_t; // type to use for the counter
+
+private: // -- data -- //
+
+	count_t count; // the count at which the range ends
+
+private: // -- helpers -- //
+
+	// creates an overload set - the return type of the function selected by passing nullptr is a type denoting if _I has a get_count() function.
+	template<typename _I>
+	static std::false_type __has_count(void*);
+	template<typename _I, std::enable_if_t<std::is_same<decltype(std::declval<const _I&>().get_count()), count_t>::value, int> = 0>
+	static std::true_type __has_count(std::nullptr_t);
+
+	// gets the current count of the (potentially wrapped) count iterator.
+	template<typename Iter>
+	static constexpr count_t __count_of(const Iter &iter)
+	{
+		if constexpr (decltype(__has_count<Iter>(nullptr))::value) return iter.get_count();
+		else return __count_of(iter.get_iter());
+	}
+
+public: // -- ctor / dtor / asgn -- //
+
+	// constructs a count sentinel that marks the end of a range at the specified count.
+	constexpr explicit count_sentinel(count_t _count) noexcept : count(_count) {}
+
+public: // -- access -- //
+
+	// gets the count at which the range ends.
+	constexpr count_t get_count() const noexcept { return count; }
+
+	// returns a count iterator equivalent to this sentinel for the range beginning at the (possibly wrapped) count iterator begin.
+	// this is begin advanced to this sentinel's count, which walks the range if it is bidirectional (so it can be walked back from).
+	// forward and input iterators can't be walked back, so for them this is begin's position with this sentinel's count - such an end
+	// compares equal to an iterator that reaches the count (counts are all that are compared), but must not be dereferenced.
+	template<typename Iter>
+	constexpr count_iterator<Iter> as_iterator(const count_iterator<Iter> &begin) const
+	{
+		typedef typename count_iterator<Iter>::iterator_category category;
+		if constexpr (std::is_same<category, std::random_access_iterator_tag>::value) return begin + (count - begin.get_count());
+		else if constexpr (std::is_same<category, std::bidirectional_iterator_tag>::value) return std::next(begin, count - begin.get_count());
+		else return count_iterator<Iter>(begin.get_iter(), count);
+	}
+
+public: // -- comparison -- //
+
+	// compares the count of the (potentially wrapped) count iterator to the sentinel count
+	template<typename Iter> constexpr friend bool operator==(const Iter &a, const count_sentinel &b) { return __count_of(a) == b.count; }
+	template<typename Iter> constexpr friend bool operator==(const count_sentinel &a, const Iter &b) { return a.count == __count_of(b); }
+	template<typename Iter> constexpr friend bool operator!=(const Iter &a, const count_sentinel &b) { return __count_of(a) != b.count; }
+	template<typename Iter> constexpr friend bool operator!=(const count_sentinel &a, const Iter &b) { return a.count != __count_of(b); }
+
+	// returns the difference of the counts of the (potentially wrapped) count iterator and the sentinel
+	template<typename Iter> constexpr friend count_t operator-(const count_sentinel &a, const Iter &b) { return a.count - __count_of(b); }
+	template<typename Iter> constexpr friend count_t operator-(const Iter &a, const count_sentinel &b) { return __count_of(a) - b.count; }
+
+	// compares two sentinels
+	constexpr friend bool operator==(const count_sentinel &a, const count_sentinel &b) noexcept { return a.count == b.count; }
+	constexpr friend bool operator!=(const count_sentinel &a, const count_sentinel &b) noexcept { return a.count != b.count; }
+};
+template<> struct is_sentinel<count_sentinel> : std::true_type {};
+
+// given the begin iterator of a range and its sentinel end, returns an end iterator of the same type as begin.
+// this is used where an algorithm requires begin and end to have the same type (e.g. the stdlib algorithms).
+template<typename Iter>
+constexpr count_iterator<Iter> sentinel_to_iterator(const count_iterator<Iter> &begin, const count_sentinel &end) { return end.as_iterator(begin); }
+
+// holds a (potentially prvalue) value by value so that an operator -> can return its address.
+// iterators whose dereference produces a temporary return one of these from operator ->.
+// the language applies -> again to the returned proxy, so the held value lives until the end of the full expression.
+template<typename T>
+class arrow_proxy
+{
+private: // -- data -- //
+
+	T value; // the held value
+
+public: // -- ctor / dtor / asgn -- //
+
+	// constructs a proxy holding the specified value.
+	constexpr explicit arrow_proxy(const T &v) : value(v) {}
+	constexpr explicit arrow_proxy(T &&v) : value(std::move(v)) {}
+
+public: // -- access -- //
+
+	// returns the address of the held value.
+	constexpr T *operator->() noexcept { return std::addressof(value); }
+	constexpr const T *operator->() const noexcept { return std::addressof(value); }
+};
+
 // contains a stored iterator and a stored function.
 // dereferencing this iterator is equivalent to dereferencing the stored iterator, passing it to the function, and using the return value.
 template<typename Iter, typename F>
-class mapping_iterator
+class mapping_iterator : private assignable_func<F>
 {
 public: // -- traits -- //
 
@@ -505,53 +889,64 @@ public: // -- traits -- //
 public: // -- types -- //
 
 	// the type of value the function will operate on
-	typedef std::decay_t<decltype((*(F*)nullptr)(std::declval<decltype(**(Iter*)nullptr)>()))> value_t;
+	typedef std::decay_t<decltype(std::declval<F&>()(*std::declval<Iter&>()))> value_t;
 
 private: // -- data -- //
 
-	Iter               iter;  // the stored iterator
-	assignable_func<F> func;  // the stored function
+	Iter iter; // the stored iterator
 
-	// optional storage location for the mapped value.
-	// this is required because operator -> needs an lvalue to take the address of, so we need to put the potentially-prvalue result somewhere.
-	mutable value_t temp_mapped_value;
+	// the stored function is held as a (private) assignable_func base so stateless functions take no space.
 
 	// true if we're supposed to be at least a random access iterator
 	static constexpr bool rand_access = std::is_same<iterator_category, std::random_access_iterator_tag>::value;
 	// true if we're supposed to be at least a bidirectional iterator
 	static constexpr bool bidirectional = rand_access || std::is_same<iterator_category, std::bidirectional_iterator_tag>::value;
 
+private: // -- helpers -- //
+
+	// aliases the stored function
+	constexpr assignable_func<F> &func() noexcept { return *this; }
+	constexpr const assignable_func<F> &func() const noexcept { return *this; }
+
 public: // -- ctor / dtor / asgn -- //
 
 	// creates a new mapping iterator from the given starting iterator and function object.
-	mapping_iterator(Iter _iter, const F &_func) : iter(std::move(_iter)), func(std::move(_func)) {}
-	mapping_iterator(Iter _iter, F &&_func) : iter(std::move(_iter)), func(std::move(_func)) {}
+	mapping_iterator(Iter _iter, const F &_func) : assignable_func<F>(_func), iter(std::move(_iter)) {}
+	mapping_iterator(Iter _iter, F &&_func) : assignable_func<F>(std::move(_func)), iter(std::move(_iter)) {}
 
 	// constructs a new mapping iterator with a copy of other's stored iterator and function.
-	constexpr mapping_iterator(const mapping_iterator &other) : iter(other.iter), func(other.func) {}
+	constexpr mapping_iterator(const mapping_iterator &other) = default;
 	// constructs a new mapping iterator by moving from other's stored iterator and function.
 	// the other iterator is left in an undefined but valid state.
-	constexpr mapping_iterator(mapping_iterator &&other) : iter(std::move(other.iter)), func(std::move(other.func)) {}
+	constexpr mapping_iterator(mapping_iterator &&other) = default;
 
 	// copies other's current iterator and function to this iterator.
-	constexpr mapping_iterator &operator=(const mapping_iterator &other) { iter = other.iter; func = other.func; return *this; }
+	constexpr mapping_iterator &operator=(const mapping_iterator &other) { iter = other.iter; func() = other.func(); return *this; }
 	// moves other's current iterator and function to this iterator.
 	// the other iterator is left in an undefined but valid state.
-	constexpr mapping_iterator &operator=(mapping_iterator &&other) { iter = std::move(other.iter); func = std::move(other.func); return *this; }
+	constexpr mapping_iterator &operator=(mapping_iterator &&other) { iter = std::move(other.iter); func() = std::move(other.func()); return *this; }
 
 public: // -- access -- //
 
 	// dereferences the stored iterator, passes it through the mapping function, and returns the result
-	constexpr decltype(auto) operator*() & { return func(*iter); }
-	constexpr decltype(auto) operator*() const& { return func(*iter); }
-	constexpr decltype(auto) operator*() && { return func(*std::move(iter)); }
+	constexpr decltype(auto) operator*() & { return func()(*iter); }
+	constexpr decltype(auto) operator*() const& { return func()(*iter); }
+	constexpr decltype(auto) operator*() && { return func()(*std::move(iter)); }
+
+	// dereferences the stored iterator, passes it through the mapping function, and returns an arrow proxy holding the result.
+	// the mapped value thus lives in the proxy until the end of the full expression containing the -> access rather than in this iterator.
+	constexpr arrow_proxy<value_t> operator->() & { return arrow_proxy<value_t>(func()(*iter)); }
+	constexpr arrow_proxy<value_t> operator->() const& { return arrow_proxy<value_t>(func()(*iter)); }
+	constexpr arrow_proxy<value_t> operator->() && { return arrow_proxy<value_t>(func()(*std::move(iter))); }
+
+public: // -- raw access -- //
 
-	// dereferences the stored iterator, and passes it through the mapping function.
-	// the result is stored to a temporary location inside this iterator and the address is returned.
-	// care should be taken, though, as the object's lifetime potentially ends on the next -> access or the destruction of this iterator.
-	constexpr value_t *operator->() & { temp_mapped_value = *iter; return std::addressof(temp_mapped_value); }
-	constexpr value_t *operator->() const& { temp_mapped_value = *iter; return std::addressof(temp_mapped_value); }
-	constexpr value_t *operator->() && = delete;
+	// gets the current stored iterator for this mapping iterator.
+	constexpr const Iter &get_iter() const& noexcept { return iter; }
+	constexpr Iter get_iter() && noexcept(std::is_nothrow_move_constructible<Iter>::value) { return std::move(iter); }
+
+	// gets the stored mapping function for this mapping iterator.
+	constexpr const F &get_func() const noexcept { return func().get(); }
 
 public: // -- inc -- //
 
@@ -572,7 +967,7 @@ public: // -- random access iterator functions -- //
 
 	// random access - returns the mapped result of indexing the stored iterator.
 	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
-	constexpr decltype(auto) operator[](difference_type d) { return func(iter[d]); }
+	constexpr decltype(auto) operator[](difference_type d) { return func()(iter[d]); }
 
 	// random access - adds d to the stored iterator.
 	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
@@ -619,263 +1014,2775 @@ public: // -- comparison -- //
 template<typename Iter, typename F>
 auto make_mapping_iterator(Iter &&iter, F &&func) { return mapping_iterator<std::decay_t<Iter>, std::decay_t<F>>(std::forward<Iter>(iter), std::forward<F>(func)); }
 
-// represents an iterator range - stores a begin() and an end() and can by used in range-based for loops
-template<typename IterBegin, typename IterEnd = IterBegin>
-class iterator_range
+// given the begin mapping iterator of a range and its sentinel end, returns an end mapping iterator (see sentinel_to_iterator for count iterators).
+template<typename Iter, typename F, typename Sentinel>
+constexpr mapping_iterator<Iter, F> sentinel_to_iterator(const mapping_iterator<Iter, F> &begin, const Sentinel &end) { return { sentinel_to_iterator(begin.get_iter(), end), begin.get_func() }; }
+
+// a mapping iterator (see mapping_iterator) that caches the mapped value of its current position.
+// the function is called at most once per position - the cache is filled by the first dereference and dropped whenever the iterator moves.
+// copies carry the cache along, so algorithms that copy an iterator and dereference both copies (e.g. adjacent_find) don't recompute the value.
+// dereferencing returns a copy of the cached value (as mapping_iterator returns a prvalue), since the cache belongs to one iterator and is destroyed
+// when it moves or is destroyed - a reference into it would dangle in e.g. std::reverse_iterator, which dereferences a temporary copy.
+// this is meant for expensive mapping functions (hashing, decoding, parsing) - for cheap ones mapping_iterator is faster, since there is no cache to check or copy.
+template<typename Iter, typename F>
+class cached_mapping_iterator : private assignable_func<F>
 {
+public: // -- types -- //
+
+	// the type of value the function will operate on
+	typedef std::decay_t<decltype(std::declval<const F&>()(*std::declval<Iter&>()))> value_t;
+
+public: // -- traits -- //
+
+	typedef typename std::iterator_traits<Iter>::iterator_category iterator_category;
+	typedef typename std::iterator_traits<Iter>::difference_type difference_type;
+
+	typedef value_t value_type;
+
+	typedef arrow_proxy<value_t> pointer;
+	typedef value_t reference;
+
 private: // -- data -- //
 
-	IterBegin _begin; // the begin iterator
-	IterEnd   _end;   // the end iterator
+	Iter iter; // the stored iterator
 
-	template<typename A, typename B> friend class iterator_range;
+	// buffer for the cached mapped value - only holds an object if has_value is true.
+	// these are mutable since dereferencing (a const operation) is what fills the cache.
+	alignas(value_t) mutable char _value[sizeof(value_t)];
+	mutable bool has_value = false;
 
-public: // -- ctor / dtor / asgn -- //
+	// the stored function is held as a (private) assignable_func base so stateless functions take no space.
 
-	// creates a new iterator range with the specified iterator range.
-	constexpr iterator_range(IterBegin b, IterEnd e) : _begin(b), _end(e) {}
+	// true if we're supposed to be at least a random access iterator
+	static constexpr bool rand_access = std::is_same<iterator_category, std::random_access_iterator_tag>::value;
+	// true if we're supposed to be at least a bidirectional iterator
+	static constexpr bool bidirectional = rand_access || std::is_same<iterator_category, std::bidirectional_iterator_tag>::value;
 
-	// creates a new iterator range that is a copy of other's iterators.
-	constexpr iterator_range(const iterator_range &other) : _begin(other._begin), _end(other._end) {}
-	// creates a new iterator range by move constructing from other's iterators.
-	constexpr iterator_range(iterator_range &&other) : _begin(std::move(other._begin)), _end(std::move(other._end)) {}
+private: // -- helpers -- //
 
-	// copy assigns other's iterators to this object.
-	constexpr iterator_range &operator=(const iterator_range &other) { _begin = other._begin; _end = other._end; return *this; }
-	// move assignes other's iterators to this object
-	constexpr iterator_range &operator=(iterator_range &&other) { _begin = std::move(other._begin); _end = std::move(other._end); return *this; }
+	// aliases the stored function
+	constexpr assignable_func<F> &func() noexcept { return *this; }
+	constexpr const assignable_func<F> &func() const noexcept { return *this; }
 
-public: // -- conversion ctor / asgn -- //
+	// aliases the buffer object
+	value_t &value() const noexcept { return reinterpret_cast<value_t&>(_value); }
 
-	// creates a new iterator range by calling std::begin() and std::end() for the given container.
-	// note that this also enables conversion between iterator_range objects of compatible iterator types.
-	template<typename Container> explicit constexpr iterator_range(Container &container) : _begin(std::begin(container)), _end(std::end(container)) {}
-	// copies the iterator range by calling std::begin() and std::end() for the given container.
-	// note that this also enables conversion between iterator_range objects of compatible iterator types.
-	template<typename Container> constexpr iterator_range &operator=(Container &container) { _begin = std::begin(container); _end = std::end(container); return *this; }
+	// destroys the cached value (if any)
+	void __reset() noexcept { if (has_value) { value().~value_t(); has_value = false; } }
 
-	// move conversion constructor for converting between iterator ranges of compatible types.
-	template<typename OtherIterBegin, typename OtherIterEnd>
-	explicit constexpr iterator_range(iterator_range<OtherIterBegin, OtherIterEnd> &&other) : _begin(std::move(other._begin)), _end(std::move(other._end)) {}
-	// move conversion operator for converting between iterator ranges of compatible types.
-	template<typename OtherIterBegin, typename OtherIterEnd>
-	constexpr iterator_range &operator=(iterator_range<OtherIterBegin, OtherIterEnd> &&other) { _begin = std::move(other._begin); _end = std::move(other._end); return *this; }
-	
-public: // -- range access -- //
+	// makes sure the cached value exists and returns it
+	const value_t &__fetch() const
+	{
+		if (!has_value)
+		{
+			new (_value) value_t(func()(*iter));
+			has_value = true;
+		}
+		return value();
+	}
 
-	// accesses the stored begin iterator.
-	constexpr IterBegin &begin() & noexcept { return _begin; }
-	constexpr const IterBegin &begin() const& noexcept { return _begin; }
-	constexpr IterBegin begin() && noexcept(std::is_nothrow_move_constructible<IterBegin>::value) { return std::move(_begin); }
+public: // -- ctor / dtor / asgn -- //
 
-	// accesses the stored end iterator.
-	constexpr IterEnd &end() & noexcept { return _end; }
-	constexpr const IterEnd &end() const& noexcept { return _end; }
-	constexpr IterEnd end() && noexcept(std::is_nothrow_move_constructible<IterEnd>::value) { return std::move(_end); }
+	// creates a new cached mapping iterator from the given starting iterator and function object.
+	// the function is not called until the first dereference.
+	cached_mapping_iterator(Iter _iter, const F &_func) : assignable_func<F>(_func), iter(std::move(_iter)) {}
+	cached_mapping_iterator(Iter _iter, F &&_func) : assignable_func<F>(std::move(_func)), iter(std::move(_iter)) {}
 
-public: // -- mapping -- //
+	~cached_mapping_iterator() { __reset(); }
 
-	// given a mapping function, returns a new iterator range that maps this range through the function.
-	template<typename F>
-	constexpr auto map(const F &func) const& -> iterator_range<mapping_iterator<IterBegin, std::decay_t<F>>, mapping_iterator<IterEnd, std::decay_t<F>>>
+	// constructs a new cached mapping iterator with a copy of other's stored iterator, function, and cached value (if any).
+	cached_mapping_iterator(const cached_mapping_iterator &other) : assignable_func<F>(other.func()), iter(other.iter), has_value(other.has_value) { if (has_value) new (_value) value_t(other.value()); }
+	// constructs a new cached mapping iterator by moving from other's stored iterator, function, and cached value (if any).
+	// the other iterator is left in an undefined but valid state.
+	cached_mapping_iterator(cached_mapping_iterator &&other) : assignable_func<F>(std::move(other.func())), iter(std::move(other.iter)), has_value(other.has_value) { if (has_value) new (_value) value_t(std::move(other.value())); }
+
+	// copies other's current stored iterator, function, and cached value (if any) to this iterator.
+	cached_mapping_iterator &operator=(const cached_mapping_iterator &other)
 	{
-		return { { _begin, func }, { _end, func } };
+		if (this == &other) return *this;
+		__reset();
+		if (other.has_value) { new (_value) value_t(other.value()); has_value = true; }
+		iter = other.iter;
+		func() = other.func();
+		return *this;
 	}
-	template<typename F>
-	constexpr auto map(const F &func) && -> iterator_range<mapping_iterator<IterBegin, std::decay_t<F>>, mapping_iterator<IterEnd, std::decay_t<F>>>
+	// moves other's current stored iterator, function, and cached value (if any) to this iterator.
+	// the other iterator is left in an undefined but valid state.
+	cached_mapping_iterator &operator=(cached_mapping_iterator &&other)
 	{
-		return { { std::move(_begin), func }, { std::move(_end), func } };
+		if (this == &other) return *this;
+		__reset();
+		if (other.has_value) { new (_value) value_t(std::move(other.value())); has_value = true; }
+		iter = std::move(other.iter);
+		func() = std::move(other.func());
+		return *this;
 	}
 
-public: // -- stdlib predicate/search wrappers -- //
+public: // -- access -- //
 
-	// equivalent to std::distance() using this range as input.
-	constexpr decltype(auto) distance() const& { return std::distance(_begin, _end); }
-	constexpr decltype(auto) distance() && { return std::distance(std::move(_begin), std::move(_end)); }
+	// returns (a copy of) the mapped value of the current position - calls the function first if it hasn't been evaluated here yet
+	value_t operator*() const& { return __fetch(); }
+	value_t operator*() && { __fetch(); return std::move(value()); }
 
-	// equivalent to std::accumulate() using this range as input.
-	template<typename T> T accumulate(T &&init) const& { return std::accumulate(_begin, _end, std::forward<T>(init)); }
-	template<typename T> T accumulate(T &&init) && { return std::accumulate(std::move(_begin), std::move(_end), std::forward<T>(init)); }
+	// returns the mapped value of the current position through a proxy - calls the function first if it hasn't been evaluated here yet
+	arrow_proxy<value_t> operator->() const { return arrow_proxy<value_t>(__fetch()); }
 
-	// equivalent to std::accumulate() using this range as input.
-	template<typename T, typename BinaryOperation>
-	T accumulate(T &&init, BinaryOperation &&op) const& { return std::accumulate(_begin, _end, std::forward<T>(init), std::forward<BinaryOperation>(op)); }
-	template<typename T, typename BinaryOperation>
-	T accumulate(T &&init, BinaryOperation &&op) && { return std::accumulate(std::move(_begin), std::move(_end), std::forward<T>(init), std::forward<BinaryOperation>(op)); }
+public: // -- raw access -- //
 
-	// equivalent to std::all_of() using this range as input.
-	template<typename UnaryPredicate>
-	constexpr bool all_of(UnaryPredicate &&p) const& { return std::all_of(_begin, _end, std::forward<UnaryPredicate>(p)); }
-	template<typename UnaryPredicate>
-	constexpr bool all_of(UnaryPredicate &&p) && { return std::all_of(std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
+	// gets the current stored iterator for this mapping iterator.
+	constexpr const Iter &get_iter() const& noexcept { return iter; }
+	constexpr Iter get_iter() && noexcept(std::is_nothrow_move_constructible<Iter>::value) { return std::move(iter); }
 
-	// equivalent to std::any_of() using this range as input.
+	// gets the stored mapping function for this mapping iterator.
+	constexpr const F &get_func() const noexcept { return func().get(); }
+
+public: // -- inc -- //
+
+	// increments the stored iterator and drops the cached value.
+	cached_mapping_iterator &operator++() { ++iter; __reset(); return *this; }
+	cached_mapping_iterator operator++(int) { cached_mapping_iterator cpy(*this); ++*this; return cpy; }
+
+public: // -- bidirectional iterator functions -- //
+
+	// bidirectional - decrements the stored iterator and drops the cached value.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && bidirectional, int> = 0>
+	cached_mapping_iterator &operator--() { --iter; __reset(); return *this; }
+	// bidirectional - decrements the stored iterator and drops the cached value.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && bidirectional, int> = 0>
+	cached_mapping_iterator operator--(int) { cached_mapping_iterator cpy(*this); --*this; return cpy; }
+
+public: // -- random access iterator functions -- //
+
+	// random access - returns the mapped result of indexing the stored iterator (this is not cached).
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	value_t operator[](difference_type d) const { return func()(iter[d]); }
+
+	// random access - adds d to the stored iterator and drops the cached value (if d is nonzero).
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	cached_mapping_iterator &operator+=(difference_type d) { if (d != 0) { iter += d; __reset(); } return *this; }
+	// random access - subtracts d from the stored iterator and drops the cached value (if d is nonzero).
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	cached_mapping_iterator &operator-=(difference_type d) { if (d != 0) { iter -= d; __reset(); } return *this; }
+
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	friend cached_mapping_iterator operator+(const cached_mapping_iterator &v, difference_type d) { cached_mapping_iterator cpy(v); cpy += d; return cpy; }
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	friend cached_mapping_iterator operator+(difference_type d, const cached_mapping_iterator &v) { cached_mapping_iterator cpy(v); cpy += d; return cpy; }
+
+	// random access - copies the current iterator state, subtracts d from it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	friend cached_mapping_iterator operator-(const cached_mapping_iterator &v, difference_type d) { cached_mapping_iterator cpy(v); cpy -= d; return cpy; }
+
+	// random access - returns the difference of the stored iterators.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend difference_type operator-(const cached_mapping_iterator &a, const cached_mapping_iterator &b) { return a.iter - b.iter; }
+
+	// random access - returns the result of comparing the stored values of iterators a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<(const cached_mapping_iterator &a, const cached_mapping_iterator &b) { return a.iter < b.iter; }
+	// random access - returns the result of comparing the stored values of iterators a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<=(const cached_mapping_iterator &a, const cached_mapping_iterator &b) { return a.iter <= b.iter; }
+	// random access - returns the result of comparing the stored values of iterators a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>(const cached_mapping_iterator &a, const cached_mapping_iterator &b) { return a.iter > b.iter; }
+	// random access - returns the result of comparing the stored values of iterators a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>=(const cached_mapping_iterator &a, const cached_mapping_iterator &b) { return a.iter >= b.iter; }
+
+public: // -- comparison -- //
+
+	// compares the stored iterators - does not compare the mapped values
+	constexpr friend bool operator==(const cached_mapping_iterator &a, const cached_mapping_iterator &b) noexcept(noexcept(a.iter == b.iter)) { return a.iter == b.iter; }
+	constexpr friend bool operator!=(const cached_mapping_iterator &a, const cached_mapping_iterator &b) noexcept(noexcept(a.iter != b.iter)) { return a.iter != b.iter; }
+};
+
+template<typename Iter, typename F>
+auto make_cached_mapping_iterator(Iter &&iter, F &&func) { return cached_mapping_iterator<std::decay_t<Iter>, std::decay_t<F>>(std::forward<Iter>(iter), std::forward<F>(func)); }
+
+// true if Iter is a cached mapping iterator (see cached_mapping_iterator)
+template<typename Iter>
+struct is_cached_mapping_iterator : std::false_type {};
+template<typename Iter, typename F>
+struct is_cached_mapping_iterator<cached_mapping_iterator<Iter, F>> : std::true_type {};
+
+// given the begin cached mapping iterator of a range and its sentinel end, returns an end cached mapping iterator (see sentinel_to_iterator for count iterators).
+template<typename Iter, typename F, typename Sentinel>
+cached_mapping_iterator<Iter, F> sentinel_to_iterator(const cached_mapping_iterator<Iter, F> &begin, const Sentinel &end) { return { sentinel_to_iterator(begin.get_iter(), end), begin.get_func() }; }
+
+// turns an ordinary mapping function into a block function (see block_func) that maps each element of a block of N elements.
+template<typename F, std::size_t N>
+class elementwise_block_func : private assignable_func<F>
+{
+public: // -- ctor / dtor / asgn -- //
+
+	// wraps the specified mapping function
+	constexpr explicit elementwise_block_func(const F &f) : assignable_func<F>(f) {}
+
+	// returns the wrapped mapping function
+	constexpr const assignable_func<F> &get_func() const noexcept { return *this; }
+
+public: // -- mapping -- //
+
+	// maps each element of the block
+	template<typename V>
+	constexpr auto operator()(const std::array<V, N> &in) const
+	{
+		const assignable_func<F> &f = *this;
+		std::array<std::decay_t<decltype(f(in[0]))>, N> out;
+		for (std::size_t i = 0; i < N; ++i) out[i] = f(in[i]);
+		return out;
+	}
+};
+
+// true if F is an elementwise block function (see elementwise_block_func)
+template<typename F>
+struct is_elementwise_block_func : std::false_type {};
+template<typename F, std::size_t N>
+struct is_elementwise_block_func<elementwise_block_func<F, N>> : std::true_type {};
+
+// wraps a block function with signature std::array<U, N>(const std::array<V, N>&) so it can be used as the function of a mapping_iterator.
+// iterator_range's accumulate(), for_each(), and copy() call the block function on whole blocks of N source elements at a time
+// (when the source is random access), which gives the compiler a fixed-width loop to vectorize (see iterator_range::map_blocks).
+// mapping a single element (e.g. dereferencing the iterator) is the slow path - the element is copied into every lane of a block,
+// so a real block function is called on a whole block (and does N elements' worth of work, side effects included) for each such element.
+// an elementwise_block_func is instead called directly on the element, so its function runs once per element as with map().
+template<typename BF, typename V, std::size_t N>
+class block_func : private assignable_func<BF>
+{
+public: // -- types -- //
+
+	static constexpr std::size_t block_size = N; // the number of elements in a block
+
+	typedef std::array<V, N> block_t; // the type of a source block
+
+private: // -- helpers -- //
+
+	// aliases the stored block function
+	constexpr assignable_func<BF> &func() noexcept { return *this; }
+	constexpr const assignable_func<BF> &func() const noexcept { return *this; }
+
+public: // -- ctor / dtor / asgn -- //
+
+	// wraps the specified block function
+	constexpr explicit block_func(const BF &f) : assignable_func<BF>(f) {}
+	constexpr explicit block_func(BF &&f) : assignable_func<BF>(std::move(f)) {}
+
+public: // -- mapping -- //
+
+	// maps a whole block of source elements
+	constexpr decltype(auto) block(const block_t &in) const { return func()(in); }
+
+	// maps a single source element (slow path unless BF is an elementwise_block_func)
+	constexpr auto operator()(const V &v) const
+	{
+		if constexpr (is_elementwise_block_func<BF>::value) return func().get().get_func()(v);
+		else
+		{
+			block_t in;
+			in.fill(v);
+			return func()(in)[0];
+		}
+	}
+};
+
+// composes mapping functions - composed_func<F1, F2, ..., Fn> calls F1 with the arguments, then passes the result to F2 and so on, returning the result of Fn.
+// the functions are held in a std::tuple base, so stateless functions take no space.
+// iterator_range::map() uses this to fuse chained maps into a single mapping_iterator (see fused_mapping).
+template<typename ...Fs>
+class composed_func : private std::tuple<Fs...>
+{
+private: // -- helpers -- //
+
+	// aliases the stored functions
+	constexpr std::tuple<Fs...> &funcs() noexcept { return *this; }
+	constexpr const std::tuple<Fs...> &funcs() const noexcept { return *this; }
+
+	// calls the functions from index I onward
+	template<std::size_t I, typename Self, typename ...Args>
+	static constexpr decltype(auto) __call(Self &self, Args &&...args)
+	{
+		if constexpr (I + 1 == sizeof...(Fs)) return std::get<I>(self.funcs())(std::forward<Args>(args)...);
+		else return __call<I + 1>(self, std::get<I>(self.funcs())(std::forward<Args>(args)...));
+	}
+
+public: // -- ctor / dtor / asgn -- //
+
+	// composes the specified functions
+	constexpr explicit composed_func(const Fs &...fs) : std::tuple<Fs...>(fs...) {}
+
+	// returns the tuple of composed functions
+	constexpr const std::tuple<Fs...> &get_funcs() const noexcept { return funcs(); }
+
+public: // -- access -- //
+
+	// calls the composed functions in order
+	template<typename ...Args>
+	constexpr decltype(auto) operator()(Args &&...args) { return __call<0>(*this, std::forward<Args>(args)...); }
+	template<typename ...Args>
+	constexpr decltype(auto) operator()(Args &&...args) const { return __call<0>(*this, std::forward<Args>(args)...); }
+};
+
+// returns the composition of f then g (see composed_func) - composing an existing composition appends to it rather than nesting.
+template<typename F, typename G>
+constexpr composed_func<F, G> compose_funcs(const F &f, const G &g) { return composed_func<F, G>(f, g); }
+template<typename ...Fs, typename G>
+constexpr composed_func<Fs..., G> compose_funcs(const composed_func<Fs...> &f, const G &g)
+{
+	return std::apply([&](const Fs &...fs) { return composed_func<Fs..., G>(fs..., g); }, f.get_funcs());
+}
+
+// true if F is a block_func (see block_func)
+template<typename F>
+struct is_block_func : std::false_type {};
+template<typename BF, typename V, std::size_t N>
+struct is_block_func<block_func<BF, V, N>> : std::true_type {};
+
+// describes mapping an iterator of type Iter through a function of type F (see iterator_range::map).
+// in general this is a mapping_iterator<Iter, F>, but mapping a mapping iterator fuses the functions into a single mapping iterator
+// over the original iterator, so chained maps don't nest iterators (block functions are never fused, either as the inner or the outer function,
+// since block mapping iterators must keep their block function to be processed a block at a time).
+template<typename Iter, typename F, typename = void>
+struct fused_mapping
+{
+	typedef mapping_iterator<Iter, F> type; // the resulting iterator type
+
+	// maps iter through func
+	static constexpr type make(Iter iter, const F &func) { return type(std::move(iter), func); }
+};
+template<typename Iter, typename F1, typename F>
+struct fused_mapping<mapping_iterator<Iter, F1>, F, std::enable_if_t<!is_block_func<F1>::value && !is_block_func<F>::value>>
+{
+	typedef mapping_iterator<Iter, decltype(compose_funcs(std::declval<const F1&>(), std::declval<const F&>()))> type; // the resulting iterator type
+
+	// maps iter through func
+	static constexpr type make(const mapping_iterator<Iter, F1> &iter, const F &func) { return type(iter.get_iter(), compose_funcs(iter.get_func(), func)); }
+	static constexpr type make(mapping_iterator<Iter, F1> &&iter, const F &func) { auto f = compose_funcs(iter.get_func(), func); return type(std::move(iter).get_iter(), std::move(f)); }
+};
+
+// the block_func type iterator_range::map_blocks() uses for a source iterator Iter, block size N, and function F.
+// F is used as the block function if it accepts a block, and is otherwise applied to each lane (see elementwise_block_func).
+template<typename Iter, std::size_t N, typename F, typename V = std::decay_t<decltype(*std::declval<const Iter&>())>>
+using block_func_t = block_func<std::conditional_t<std::is_invocable<const F&, const std::array<V, N>&>::value, std::decay_t<F>, elementwise_block_func<std::decay_t<F>, N>>, V, N>;
+
+// true if Iter is a mapping iterator over a block function (see block_func)
+template<typename Iter>
+struct is_block_mapping_iterator : std::false_type {};
+template<typename Iter, typename BF, typename V, std::size_t N>
+struct is_block_mapping_iterator<mapping_iterator<Iter, block_func<BF, V, N>>> : std::true_type {};
+
+// an end marker for filter iterators over ranges that end in a sentinel (see filter_iterator).
+// filter iterators already store the end of their underlying range, so this holds nothing -
+// filter iterators (or adaptors wrapping a filter iterator, which expose it via get_iter()) compare equal to it once they reach that end.
+class filter_sentinel
+{
+private: // -- helpers -- //
+
+	// creates an overload set - the return type of the function selected by passing nullptr is a type denoting if _I has an at_end() function.
+	template<typename _I>
+	static std::false_type __has_at_end(void*);
+	template<typename _I, std::enable_if_t<std::is_same<decltype(std::declval<const _I&>().at_end()), bool>::value, int> = 0>
+	static std::true_type __has_at_end(std::nullptr_t);
+
+	// checks if the (potentially wrapped) filter iterator has reached its end.
+	template<typename Iter>
+	static constexpr bool __at_end_of(const Iter &iter)
+	{
+		if constexpr (decltype(__has_at_end<Iter>(nullptr))::value) return iter.at_end();
+		else return __at_end_of(iter.get_iter());
+	}
+
+public: // -- comparison -- //
+
+	// checks if the (potentially wrapped) filter iterator has reached its end
+	template<typename Iter> constexpr friend bool operator==(const Iter &a, const filter_sentinel&) { return __at_end_of(a); }
+	template<typename Iter> constexpr friend bool operator==(const filter_sentinel&, const Iter &b) { return __at_end_of(b); }
+	template<typename Iter> constexpr friend bool operator!=(const Iter &a, const filter_sentinel&) { return !__at_end_of(a); }
+	template<typename Iter> constexpr friend bool operator!=(const filter_sentinel&, const Iter &b) { return !__at_end_of(b); }
+
+	// compares two sentinels
+	constexpr friend bool operator==(const filter_sentinel&, const filter_sentinel&) noexcept { return true; }
+	constexpr friend bool operator!=(const filter_sentinel&, const filter_sentinel&) noexcept { return false; }
+};
+template<> struct is_sentinel<filter_sentinel> : std::true_type {};
+
+// contains a stored iterator, the end of its range, and a predicate - this iterates over only the elements of the range that satisfy the predicate.
+// the stored iterator is always left at the next match (or the end), so the predicate is evaluated once per element and dereferencing does no predicate work.
+// End may be a sentinel (e.g. count_sentinel), in which case the range of filter iterators ends in a filter_sentinel.
+// this is at most a bidirectional iterator (decrementing requires a match before the current position, as for any other iterator).
+template<typename Iter, typename Pred, typename End = Iter>
+class filter_iterator : private assignable_func<Pred>
+{
+public: // -- traits -- //
+
+	typedef std::conditional_t<std::is_base_of<std::bidirectional_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>::value,
+		std::bidirectional_iterator_tag, typename std::iterator_traits<Iter>::iterator_category> iterator_category;
+	typedef typename std::iterator_traits<Iter>::difference_type difference_type;
+
+	typedef typename std::iterator_traits<Iter>::value_type value_type;
+
+	typedef typename std::iterator_traits<Iter>::pointer pointer;
+	typedef typename std::iterator_traits<Iter>::reference reference;
+
+private: // -- data -- //
+
+	Iter iter; // the stored iterator - always at a match or the end
+	End  end;  // the end of the stored iterator's range
+
+	// the predicate is held as a (private) assignable_func base so stateless predicates take no space.
+
+	// true if we're supposed to be a bidirectional iterator
+	static constexpr bool bidirectional = std::is_same<iterator_category, std::bidirectional_iterator_tag>::value;
+
+private: // -- helpers -- //
+
+	// aliases the stored predicate
+	constexpr assignable_func<Pred> &pred() noexcept { return *this; }
+	constexpr const assignable_func<Pred> &pred() const noexcept { return *this; }
+
+	// advances the stored iterator to the next match (or the end), starting at the current position.
+	constexpr void __satisfy() { while (iter != end && !pred()(*iter)) ++iter; }
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates a new filter iterator at the first match in the range [_iter, _end) of the given predicate.
+	constexpr filter_iterator(Iter _iter, End _end, const Pred &_pred) : assignable_func<Pred>(_pred), iter(std::move(_iter)), end(std::move(_end)) { __satisfy(); }
+
+	// constructs a new filter iterator with a copy of other's stored iterators and predicate.
+	constexpr filter_iterator(const filter_iterator &other) = default;
+	// constructs a new filter iterator by moving from other's stored iterators and predicate.
+	// the other iterator is left in an undefined but valid state.
+	constexpr filter_iterator(filter_iterator &&other) = default;
+
+	// copies other's current iterators and predicate to this iterator.
+	constexpr filter_iterator &operator=(const filter_iterator &other) { iter = other.iter; end = other.end; pred() = other.pred(); return *this; }
+	// moves other's current iterators and predicate to this iterator.
+	// the other iterator is left in an undefined but valid state.
+	constexpr filter_iterator &operator=(filter_iterator &&other) { iter = std::move(other.iter); end = std::move(other.end); pred() = std::move(other.pred()); return *this; }
+
+public: // -- access -- //
+
+	// returns the value of dereferencing the stored iterator.
+	constexpr decltype(auto) operator*() & { return *iter; }
+	constexpr decltype(auto) operator*() const& { return *iter; }
+	constexpr decltype(auto) operator*() && { return *std::move(iter); }
+
+	// returns the value of using the arrow operator on the stored iterator.
+	constexpr decltype(auto) operator->() const
+	{
+		if constexpr (std::is_pointer<Iter>::value) return iter;
+		else return iter.operator->();
+	}
+
+public: // -- raw access -- //
+
+	// gets the current stored iterator for this filter iterator.
+	constexpr const Iter &get_iter() const& noexcept { return iter; }
+	constexpr Iter get_iter() && noexcept(std::is_nothrow_move_constructible<Iter>::value) { return std::move(iter); }
+
+	// gets the end of the stored iterator's range.
+	constexpr const End &get_end() const noexcept { return end; }
+
+	// gets the stored predicate for this filter iterator.
+	constexpr const Pred &get_pred() const noexcept { return pred().get(); }
+
+	// returns true if this iterator has reached the end of its range.
+	constexpr bool at_end() const { return !(iter != end); }
+
+public: // -- forward iterator functions -- //
+
+	// advances the stored iterator to the next match.
+	constexpr filter_iterator &operator++() { ++iter; __satisfy(); return *this; }
+	constexpr filter_iterator operator++(int) { filter_iterator cpy(*this); ++*this; return cpy; }
+
+public: // -- bidirectional iterator functions -- //
+
+	// bidirectional - moves the stored iterator back to the previous match.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && bidirectional, int> = 0>
+	constexpr filter_iterator &operator--() { do --iter; while (!pred()(*iter)); return *this; }
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && bidirectional, int> = 0>
+	constexpr filter_iterator operator--(int) { filter_iterator cpy(*this); --*this; return cpy; }
+
+public: // -- comparison -- //
+
+	// compares the stored iterators - does not compare the ends or predicates
+	constexpr friend bool operator==(const filter_iterator &a, const filter_iterator &b) { return a.iter == b.iter; }
+	constexpr friend bool operator!=(const filter_iterator &a, const filter_iterator &b) { return a.iter != b.iter; }
+};
+
+// creates a filter iterator at the first match of pred in the range [iter, end).
+template<typename Iter, typename End, typename Pred>
+auto make_filter_iterator(Iter &&iter, End &&end, Pred &&pred) { return filter_iterator<std::decay_t<Iter>, std::decay_t<Pred>, std::decay_t<End>>(std::forward<Iter>(iter), std::forward<End>(end), std::forward<Pred>(pred)); }
+
+// given the begin filter iterator of a range and its filter_sentinel end, returns an end filter iterator (see sentinel_to_iterator for count iterators).
+template<typename Iter, typename Pred, typename End>
+constexpr filter_iterator<Iter, Pred, End> sentinel_to_iterator(const filter_iterator<Iter, Pred, End> &begin, const filter_sentinel&)
+{
+	if constexpr (is_sentinel<End>::value) return { sentinel_to_iterator(begin.get_iter(), begin.get_end()), begin.get_end(), begin.get_pred() };
+	else return { begin.get_end(), begin.get_end(), begin.get_pred() };
+}
+
+// contains a stored iterator, the end of its range, and a stride - this iterates over every stride-th element of the range, starting with the first.
+// the stored iterator never moves past the end of its range - a step that would overshoot stops at the end instead
+// (random access iterators remember how far they fell short, so stepping back from the end and differences stay exact).
+// this is a random access iterator if Iter is, otherwise it is at most a forward iterator. the stride must be positive.
+template<typename Iter, typename End = Iter>
+class stride_iterator
+{
+public: // -- traits -- //
+
+	typedef std::conditional_t<std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>::value, std::random_access_iterator_tag,
+		std::conditional_t<std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>::value, std::forward_iterator_tag,
+		typename std::iterator_traits<Iter>::iterator_category>> iterator_category;
+	typedef typename std::iterator_traits<Iter>::difference_type difference_type;
+
+	typedef typename std::iterator_traits<Iter>::value_type value_type;
+
+	typedef typename std::iterator_traits<Iter>::pointer pointer;
+	typedef typename std::iterator_traits<Iter>::reference reference;
+
+private: // -- data -- //
+
+	Iter            iter;        // the stored iterator - never past end
+	End             end;         // the end of the stored iterator's range
+	difference_type stride;      // the number of underlying elements per step
+	difference_type missing = 0; // random access - the part of the last step that was cut short by the end (zero unless at the end)
+
+	// true if we're supposed to be a random access iterator
+	static constexpr bool rand_access = std::is_same<iterator_category, std::random_access_iterator_tag>::value;
+
+private: // -- helpers -- //
+
+	// advances the stored iterator by n underlying elements (n >= 0), stopping at the end - returns the number of elements that were cut short.
+	constexpr difference_type __advance(difference_type n)
+	{
+		if constexpr (rand_access)
+		{
+			const difference_type left = static_cast<difference_type>(end - iter);
+			if (n > left) { iter += left; return n - left; }
+			iter += n;
+			return 0;
+		}
+		else
+		{
+			for (; n > 0 && iter != end; --n) ++iter;
+			return n;
+		}
+	}
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates a new stride iterator at _iter in the range [_iter, _end) which moves by _stride elements per step.
+	// _missing is the part of the last step that was cut short by the end (see iterator_range::stride()) - it is only meaningful for random access iterators at the end.
+	constexpr stride_iterator(Iter _iter, End _end, difference_type _stride, difference_type _missing = 0) : iter(std::move(_iter)), end(std::move(_end)), stride(_stride), missing(_missing) {}
+
+public: // -- access -- //
+
+	// returns the value of dereferencing the stored iterator.
+	constexpr decltype(auto) operator*() & { return *iter; }
+	constexpr decltype(auto) operator*() const& { return *iter; }
+	constexpr decltype(auto) operator*() && { return *std::move(iter); }
+
+	// returns the value of using the arrow operator on the stored iterator.
+	constexpr decltype(auto) operator->() const
+	{
+		if constexpr (std::is_pointer<Iter>::value) return iter;
+		else return iter.operator->();
+	}
+
+public: // -- raw access -- //
+
+	// gets the current stored iterator for this stride iterator.
+	constexpr const Iter &get_iter() const& noexcept { return iter; }
+	constexpr Iter get_iter() && noexcept(std::is_nothrow_move_constructible<Iter>::value) { return std::move(iter); }
+
+	// gets the end of the stored iterator's range.
+	constexpr const End &get_end() const noexcept { return end; }
+
+	// gets the stride (the number of underlying elements per step).
+	constexpr difference_type get_stride() const noexcept { return stride; }
+
+public: // -- forward iterator functions -- //
+
+	// advances the stored iterator by the stride, or to the end if that comes first.
+	constexpr stride_iterator &operator++() { missing = __advance(stride); return *this; }
+	constexpr stride_iterator operator++(int) { stride_iterator cpy(*this); ++*this; return cpy; }
+
+public: // -- bidirectional iterator functions -- //
+
+	// random access - moves the stored iterator back by one step (a step cut short by the end is only undone as far as it went).
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr stride_iterator &operator--() { iter -= stride - missing; missing = 0; return *this; }
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr stride_iterator operator--(int) { stride_iterator cpy(*this); --*this; return cpy; }
+
+public: // -- random access iterator functions -- //
+
+	// random access - returns the result of dereferencing the position d steps away.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr decltype(auto) operator[](difference_type d) const { return *(*this + d); }
+
+	// random access - moves d steps, stopping at the end when moving forward.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr stride_iterator &operator+=(difference_type d)
+	{
+		if (d > 0) missing = __advance(d * stride);
+		else if (d < 0) { iter += d * stride + missing; missing = 0; }
+		return *this;
+	}
+	// random access - moves -d steps (see operator+=).
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr stride_iterator &operator-=(difference_type d) { return *this += -d; }
+
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend stride_iterator operator+(const stride_iterator &v, difference_type d) { stride_iterator cpy(v); cpy += d; return cpy; }
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend stride_iterator operator+(difference_type d, const stride_iterator &v) { stride_iterator cpy(v); cpy += d; return cpy; }
+
+	// random access - copies the current iterator state, subtracts d from it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend stride_iterator operator-(const stride_iterator &v, difference_type d) { stride_iterator cpy(v); cpy -= d; return cpy; }
+
+	// random access - returns the number of steps between the iterators (counting a step cut short by the end as a whole step).
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend difference_type operator-(const stride_iterator &a, const stride_iterator &b) { return static_cast<difference_type>((a.iter - b.iter) + a.missing - b.missing) / a.stride; }
+
+	// random access - returns the result of comparing the stored iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<(const stride_iterator &a, const stride_iterator &b) { return a.iter < b.iter; }
+	// random access - returns the result of comparing the stored iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<=(const stride_iterator &a, const stride_iterator &b) { return a.iter <= b.iter; }
+	// random access - returns the result of comparing the stored iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>(const stride_iterator &a, const stride_iterator &b) { return a.iter > b.iter; }
+	// random access - returns the result of comparing the stored iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>=(const stride_iterator &a, const stride_iterator &b) { return a.iter >= b.iter; }
+
+public: // -- comparison -- //
+
+	// compares the stored iterators - does not compare the ends or strides
+	constexpr friend bool operator==(const stride_iterator &a, const stride_iterator &b) { return a.iter == b.iter; }
+	constexpr friend bool operator!=(const stride_iterator &a, const stride_iterator &b) { return a.iter != b.iter; }
+};
+
+template<typename IterBegin, typename IterEnd> class iterator_range;
+
+// walks a range a chunk of (up to) n elements at a time - dereferencing gives the chunk as an iterator_range<Iter, Iter> over the source
+// (so pointer ranges give raw pointer spans), and the last chunk may be partial. this moves like a stride iterator with a stride of n
+// (see stride_iterator), so it is random access if Iter is, in which case the number of chunks is found in constant time.
+template<typename Iter, typename End = Iter>
+class chunk_iterator
+{
+public: // -- traits -- //
+
+	typedef typename stride_iterator<Iter, End>::iterator_category iterator_category;
+	typedef typename stride_iterator<Iter, End>::difference_type difference_type;
+
+	typedef iterator_range<Iter, Iter> value_type;
+
+	typedef arrow_proxy<value_type> pointer;
+	typedef value_type reference;
+
+private: // -- data -- //
+
+	stride_iterator<Iter, End> iter; // the stored stride iterator - its stride is the chunk size
+
+	// true if we're supposed to be at least a random access iterator
+	static constexpr bool rand_access = std::is_same<iterator_category, std::random_access_iterator_tag>::value;
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates a new chunk iterator from the given stride iterator - the stride is the chunk size.
+	constexpr explicit chunk_iterator(stride_iterator<Iter, End> _iter) : iter(std::move(_iter)) {}
+
+public: // -- access -- //
+
+	// returns the current chunk - this is the range from the current position to the next one (or the end).
+	// for random access iterators this is constant time, otherwise it walks the chunk to find its end.
+	constexpr value_type operator*() const { stride_iterator<Iter, End> next = iter; ++next; return value_type(iter.get_iter(), std::move(next).get_iter()); }
+
+	// returns an arrow proxy holding the current chunk (see arrow_proxy).
+	constexpr pointer operator->() const { return pointer(**this); }
+
+public: // -- raw access -- //
+
+	// gets the stored stride iterator.
+	constexpr const stride_iterator<Iter, End> &get_iter() const& noexcept { return iter; }
+	constexpr stride_iterator<Iter, End> get_iter() && noexcept(std::is_nothrow_move_constructible<stride_iterator<Iter, End>>::value) { return std::move(iter); }
+
+public: // -- forward iterator functions -- //
+
+	// moves to the next chunk
+	constexpr chunk_iterator &operator++() { ++iter; return *this; }
+	constexpr chunk_iterator operator++(int) { chunk_iterator cpy(*this); ++iter; return cpy; }
+
+public: // -- bidirectional iterator functions -- //
+
+	// random access - moves to the previous chunk.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr chunk_iterator &operator--() { --iter; return *this; }
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr chunk_iterator operator--(int) { chunk_iterator cpy(*this); --iter; return cpy; }
+
+public: // -- random access iterator functions -- //
+
+	// random access - returns the chunk d chunks away.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr value_type operator[](difference_type d) const { return *(*this + d); }
+
+	// random access - moves d chunks.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr chunk_iterator &operator+=(difference_type d) { iter += d; return *this; }
+	// random access - moves -d chunks.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr chunk_iterator &operator-=(difference_type d) { iter -= d; return *this; }
+
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend chunk_iterator operator+(const chunk_iterator &v, difference_type d) { chunk_iterator cpy(v); cpy += d; return cpy; }
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend chunk_iterator operator+(difference_type d, const chunk_iterator &v) { chunk_iterator cpy(v); cpy += d; return cpy; }
+
+	// random access - copies the current iterator state, subtracts d from it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend chunk_iterator operator-(const chunk_iterator &v, difference_type d) { chunk_iterator cpy(v); cpy -= d; return cpy; }
+
+	// random access - returns the number of chunks between the iterators.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend difference_type operator-(const chunk_iterator &a, const chunk_iterator &b) { return a.iter - b.iter; }
+
+	// random access - returns the result of comparing the stored iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<(const chunk_iterator &a, const chunk_iterator &b) { return a.iter < b.iter; }
+	// random access - returns the result of comparing the stored iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<=(const chunk_iterator &a, const chunk_iterator &b) { return a.iter <= b.iter; }
+	// random access - returns the result of comparing the stored iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>(const chunk_iterator &a, const chunk_iterator &b) { return a.iter > b.iter; }
+	// random access - returns the result of comparing the stored iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>=(const chunk_iterator &a, const chunk_iterator &b) { return a.iter >= b.iter; }
+
+public: // -- comparison -- //
+
+	// compares the stored iterators
+	constexpr friend bool operator==(const chunk_iterator &a, const chunk_iterator &b) { return a.iter == b.iter; }
+	constexpr friend bool operator!=(const chunk_iterator &a, const chunk_iterator &b) { return a.iter != b.iter; }
+};
+
+// contains several stored iterators which are moved in lock step - dereferencing gives a std::tuple of the results of dereferencing each of them.
+// this is meant for struct-of-arrays data, where the iterators walk parallel sequences (e.g. ids, timestamps, and values).
+// only the first iterator is compared (and differenced), so the other sequences must be at least as long as the first.
+// the iterator category is the weakest of the stored iterators' categories (e.g. random access for pointers).
+template<typename Iter, typename ...Iters>
+class zip_iterator
+{
+public: // -- traits -- //
+
+	typedef std::common_type_t<typename std::iterator_traits<Iter>::iterator_category, typename std::iterator_traits<Iters>::iterator_category...> iterator_category;
+	typedef std::common_type_t<typename std::iterator_traits<Iter>::difference_type, typename std::iterator_traits<Iters>::difference_type...> difference_type;
+
+	typedef std::tuple<typename std::iterator_traits<Iter>::value_type, typename std::iterator_traits<Iters>::value_type...> value_type;
+
+	typedef std::tuple<decltype(*std::declval<const Iter&>()), decltype(*std::declval<const Iters&>())...> reference;
+	typedef arrow_proxy<reference> pointer;
+
+private: // -- data -- //
+
+	std::tuple<Iter, Iters...> iters; // the stored iterators
+
+	// true if we're supposed to be at least a random access iterator
+	static constexpr bool rand_access = std::is_same<iterator_category, std::random_access_iterator_tag>::value;
+	// true if we're supposed to be at least a bidirectional iterator
+	static constexpr bool bidirectional = rand_access || std::is_same<iterator_category, std::bidirectional_iterator_tag>::value;
+
+private: // -- helpers -- //
+
+	// applies op to each of the stored iterators
+	template<typename Op>
+	constexpr void __each(Op &&op) { std::apply([&](auto &...it) { (op(it), ...); }, iters); }
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates a new zip iterator from the given iterators.
+	constexpr explicit zip_iterator(Iter _iter, Iters ..._iters) : iters(std::move(_iter), std::move(_iters)...) {}
+
+public: // -- access -- //
+
+	// returns a tuple of the results of dereferencing each of the stored iterators
+	constexpr reference operator*() const { return std::apply([](const auto &...it) { return reference(*it...); }, iters); }
+
+	// returns an arrow proxy holding the tuple of dereferenced values (see arrow_proxy).
+	constexpr pointer operator->() const { return pointer(**this); }
+
+public: // -- raw access -- //
+
+	// gets the first stored iterator - this is the one that is compared and differenced.
+	constexpr const Iter &get_iter() const& noexcept { return std::get<0>(iters); }
+	constexpr Iter get_iter() && noexcept(std::is_nothrow_move_constructible<Iter>::value) { return std::get<0>(std::move(iters)); }
+
+	// gets the tuple of all the stored iterators.
+	constexpr const std::tuple<Iter, Iters...> &get_iters() const noexcept { return iters; }
+
+public: // -- forward iterator functions -- //
+
+	// increments each of the stored iterators
+	constexpr zip_iterator &operator++() { __each([](auto &it) { ++it; }); return *this; }
+	constexpr zip_iterator operator++(int) { zip_iterator cpy(*this); ++*this; return cpy; }
+
+public: // -- bidirectional iterator functions -- //
+
+	// bidirectional - decrements each of the stored iterators.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && bidirectional, int> = 0>
+	constexpr zip_iterator &operator--() { __each([](auto &it) { --it; }); return *this; }
+	// bidirectional - decrements each of the stored iterators.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && bidirectional, int> = 0>
+	constexpr zip_iterator operator--(int) { zip_iterator cpy(*this); --*this; return cpy; }
+
+public: // -- random access iterator functions -- //
+
+	// random access - returns a tuple of the results of indexing each of the stored iterators.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr auto operator[](difference_type d) const { return std::apply([d](const auto &...it) { return std::tuple<decltype(it[d])...>(it[d]...); }, iters); }
+
+	// random access - adds d to each of the stored iterators.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr zip_iterator &operator+=(difference_type d) { __each([d](auto &it) { it += d; }); return *this; }
+	// random access - subtracts d from each of the stored iterators.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr zip_iterator &operator-=(difference_type d) { __each([d](auto &it) { it -= d; }); return *this; }
+
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend zip_iterator operator+(const zip_iterator &v, difference_type d) { zip_iterator cpy(v); cpy += d; return cpy; }
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend zip_iterator operator+(difference_type d, const zip_iterator &v) { zip_iterator cpy(v); cpy += d; return cpy; }
+
+	// random access - copies the current iterator state, subtracts d from it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend zip_iterator operator-(const zip_iterator &v, difference_type d) { zip_iterator cpy(v); cpy -= d; return cpy; }
+
+	// random access - returns the difference of the first stored iterators.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend difference_type operator-(const zip_iterator &a, const zip_iterator &b) { return std::get<0>(a.iters) - std::get<0>(b.iters); }
+
+	// random access - returns the result of comparing the first stored iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<(const zip_iterator &a, const zip_iterator &b) { return std::get<0>(a.iters) < std::get<0>(b.iters); }
+	// random access - returns the result of comparing the first stored iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<=(const zip_iterator &a, const zip_iterator &b) { return std::get<0>(a.iters) <= std::get<0>(b.iters); }
+	// random access - returns the result of comparing the first stored iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>(const zip_iterator &a, const zip_iterator &b) { return std::get<0>(a.iters) > std::get<0>(b.iters); }
+	// random access - returns the result of comparing the first stored iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>=(const zip_iterator &a, const zip_iterator &b) { return std::get<0>(a.iters) >= std::get<0>(b.iters); }
+
+public: // -- comparison -- //
+
+	// compares the first stored iterators - the others are not compared
+	constexpr friend bool operator==(const zip_iterator &a, const zip_iterator &b) { return std::get<0>(a.iters) == std::get<0>(b.iters); }
+	constexpr friend bool operator!=(const zip_iterator &a, const zip_iterator &b) { return std::get<0>(a.iters) != std::get<0>(b.iters); }
+};
+
+// creates a zip iterator from the given iterators.
+template<typename Iter, typename ...Iters>
+auto make_zip_iterator(Iter &&iter, Iters &&...iters) { return zip_iterator<std::decay_t<Iter>, std::decay_t<Iters>...>(std::forward<Iter>(iter), std::forward<Iters>(iters)...); }
+
+// given the begin zip iterator of a range and the sentinel end of its first iterator, returns an end zip iterator (see sentinel_to_iterator for count iterators).
+// all the stored iterators are advanced by the length of the range - in constant time if the zip iterator is random access.
+template<typename Iter, typename ...Iters, typename Sentinel>
+constexpr zip_iterator<Iter, Iters...> sentinel_to_iterator(const zip_iterator<Iter, Iters...> &begin, const Sentinel &end)
+{
+	if constexpr (std::is_same<typename zip_iterator<Iter, Iters...>::iterator_category, std::random_access_iterator_tag>::value)
+		return begin + static_cast<typename zip_iterator<Iter, Iters...>::difference_type>(end - begin.get_iter());
+	else { zip_iterator<Iter, Iters...> last = begin; while (last != end) ++last; return last; }
+}
+
+// an end marker holding the end iterator of an underlying range, for adaptors whose own end can't be formed cheaply (see iterator_range::enumerate()).
+// adaptors that expose their underlying iterator via get_iter() compare equal to it when the (outermost) wrapped iterator of type Iter equals the held one.
+template<typename Iter>
+class iterator_sentinel
+{
+private: // -- data -- //
+
+	Iter end; // the end iterator of the underlying range
+
+private: // -- helpers -- //
+
+	// compares the (potentially wrapped) iterator of type Iter in iter to the held end.
+	template<typename I>
+	constexpr bool __at_end(const I &iter) const
+	{
+		if constexpr (std::is_same<I, Iter>::value) return iter == end;
+		else return __at_end(iter.get_iter());
+	}
+
+public: // -- ctor / dtor / asgn -- //
+
+	// constructs a sentinel for the underlying range ending at _end.
+	constexpr explicit iterator_sentinel(Iter _end) : end(std::move(_end)) {}
+
+public: // -- access -- //
+
+	// gets the end iterator of the underlying range.
+	constexpr const Iter &get_end() const noexcept { return end; }
+
+public: // -- comparison -- //
+
+	// compares the (potentially wrapped) underlying iterator to the held end
+	template<typename I> constexpr friend bool operator==(const I &a, const iterator_sentinel &b) { return b.__at_end(a); }
+	template<typename I> constexpr friend bool operator==(const iterator_sentinel &a, const I &b) { return a.__at_end(b); }
+	template<typename I> constexpr friend bool operator!=(const I &a, const iterator_sentinel &b) { return !b.__at_end(a); }
+	template<typename I> constexpr friend bool operator!=(const iterator_sentinel &a, const I &b) { return !a.__at_end(b); }
+
+	// compares two sentinels
+	constexpr friend bool operator==(const iterator_sentinel &a, const iterator_sentinel &b) { return a.end == b.end; }
+	constexpr friend bool operator!=(const iterator_sentinel &a, const iterator_sentinel &b) { return a.end != b.end; }
+};
+template<typename Iter> struct is_sentinel<iterator_sentinel<Iter>> : std::true_type {};
+
+// the underlying iterator type of a count iterator, or Iter itself if it isn't a count iterator.
+template<typename Iter> struct uncounted { typedef Iter type; };
+template<typename Iter> struct uncounted<count_iterator<Iter>> { typedef Iter type; };
+
+// wraps a count iterator and dereferences to a std::pair of the current count and the result of dereferencing the count iterator.
+// the count is the count iterator's own counter, so enumerating costs no extra increment - this has the same iterator category as Iter
+// (e.g. random access over pointers and value iterators) and compares, differences, and advances exactly like the count iterator.
+template<typename Iter>
+class enumerate_iterator
+{
+public: // -- types -- //
+
+	typedef typename count_iterator<Iter>::count_t count_t; // type of the count
+
+public: // -- traits -- //
+
+	typedef typename count_iterator<Iter>::iterator_category iterator_category;
+	typedef typename count_iterator<Iter>::difference_type difference_type;
+
+	typedef std::pair<count_t, typename std::iterator_traits<Iter>::value_type> value_type;
+
+	typedef std::pair<count_t, decltype(*std::declval<const Iter&>())> reference;
+	typedef arrow_proxy<reference> pointer;
+
+private: // -- data -- //
+
+	count_iterator<Iter> iter; // the stored count iterator
+
+	// true if we're supposed to be at least a random access iterator
+	static constexpr bool rand_access = std::is_same<iterator_category, std::random_access_iterator_tag>::value;
+	// true if we're supposed to be at least a bidirectional iterator
+	static constexpr bool bidirectional = rand_access || std::is_same<iterator_category, std::bidirectional_iterator_tag>::value;
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates a new enumerate iterator from the given count iterator.
+	constexpr explicit enumerate_iterator(count_iterator<Iter> _iter) : iter(std::move(_iter)) {}
+
+public: // -- access -- //
+
+	// returns the pair of the current count and the result of dereferencing the stored iterator
+	constexpr reference operator*() const { return reference(iter.get_count(), *iter); }
+
+	// returns an arrow proxy holding the (count, value) pair (see arrow_proxy).
+	constexpr pointer operator->() const { return pointer(**this); }
+
+public: // -- raw access -- //
+
+	// gets the stored count iterator.
+	constexpr const count_iterator<Iter> &get_iter() const& noexcept { return iter; }
+	constexpr count_iterator<Iter> get_iter() && noexcept(std::is_nothrow_move_constructible<count_iterator<Iter>>::value) { return std::move(iter); }
+
+	// gets the current count.
+	constexpr count_t get_count() const noexcept { return iter.get_count(); }
+
+public: // -- forward iterator functions -- //
+
+	// increments the stored count iterator
+	constexpr enumerate_iterator &operator++() { ++iter; return *this; }
+	constexpr enumerate_iterator operator++(int) { enumerate_iterator cpy(*this); ++iter; return cpy; }
+
+public: // -- bidirectional iterator functions -- //
+
+	// bidirectional - decrements the stored count iterator.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && bidirectional, int> = 0>
+	constexpr enumerate_iterator &operator--() { --iter; return *this; }
+	// bidirectional - decrements the stored count iterator.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && bidirectional, int> = 0>
+	constexpr enumerate_iterator operator--(int) { enumerate_iterator cpy(*this); --iter; return cpy; }
+
+public: // -- random access iterator functions -- //
+
+	// random access - returns the pair of the count and the result of indexing the stored iterator.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr auto operator[](difference_type d) const { return std::pair<count_t, decltype(iter.get_iter()[d])>(iter.get_count() + d, iter.get_iter()[d]); }
+
+	// random access - adds d to the stored count iterator.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr enumerate_iterator &operator+=(difference_type d) { iter += d; return *this; }
+	// random access - subtracts d from the stored count iterator.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr enumerate_iterator &operator-=(difference_type d) { iter -= d; return *this; }
+
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend enumerate_iterator operator+(const enumerate_iterator &v, difference_type d) { enumerate_iterator cpy(v); cpy += d; return cpy; }
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend enumerate_iterator operator+(difference_type d, const enumerate_iterator &v) { enumerate_iterator cpy(v); cpy += d; return cpy; }
+
+	// random access - copies the current iterator state, subtracts d from it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend enumerate_iterator operator-(const enumerate_iterator &v, difference_type d) { enumerate_iterator cpy(v); cpy -= d; return cpy; }
+
+	// random access - returns the difference of the stored count iterators.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend difference_type operator-(const enumerate_iterator &a, const enumerate_iterator &b) { return a.iter - b.iter; }
+
+	// random access - returns the result of comparing the stored count iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<(const enumerate_iterator &a, const enumerate_iterator &b) { return a.iter < b.iter; }
+	// random access - returns the result of comparing the stored count iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<=(const enumerate_iterator &a, const enumerate_iterator &b) { return a.iter <= b.iter; }
+	// random access - returns the result of comparing the stored count iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>(const enumerate_iterator &a, const enumerate_iterator &b) { return a.iter > b.iter; }
+	// random access - returns the result of comparing the stored count iterators of a and b
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>=(const enumerate_iterator &a, const enumerate_iterator &b) { return a.iter >= b.iter; }
+
+public: // -- comparison -- //
+
+	// compares the stored count iterators (i.e. the counts)
+	constexpr friend bool operator==(const enumerate_iterator &a, const enumerate_iterator &b) { return a.iter == b.iter; }
+	constexpr friend bool operator!=(const enumerate_iterator &a, const enumerate_iterator &b) { return a.iter != b.iter; }
+};
+
+// given the begin enumerate iterator of a range and its sentinel end, returns an end enumerate iterator (see sentinel_to_iterator for count iterators).
+// this is constant time for count sentinels - other sentinels are found by walking the range.
+template<typename Iter, typename Sentinel>
+constexpr enumerate_iterator<Iter> sentinel_to_iterator(const enumerate_iterator<Iter> &begin, const Sentinel &end)
+{
+	if constexpr (std::is_same<Sentinel, count_sentinel>::value) return enumerate_iterator<Iter>(end.as_iterator(begin.get_iter()));
+	else { enumerate_iterator<Iter> last = begin; while (last != end) ++last; return last; }
+}
+
+// walks several ranges (segments) with the same iterator type one after the other, as if they were a single range.
+// the N segments are held in the iterator itself, so copies are O(N) - this is meant for a handful of buffers (e.g. per-thread results).
+// this is a segmented iterator: iterator_range's accumulate(), for_each(), find(), count_if(), and copy() (among others) see through it
+// and run their loop over each segment's own iterators, instead of checking for the end of a segment on every increment.
+// the stored iterator is never left at the end of a segment other than the last one (empty segments are skipped).
+// this has the same iterator category as Iter - random access jumps and differences take time linear in the number of segments.
+template<typename Iter, std::size_t N>
+class concat_iterator
+{
+	static_assert(N > 0, "a concat iterator needs at least one segment");
+
+public: // -- types -- //
+
+	typedef std::array<std::pair<Iter, Iter>, N> segments_t; // the [begin, end) iterator pairs of the segments
+
+public: // -- traits -- //
+
+	typedef typename std::iterator_traits<Iter>::iterator_category iterator_category;
+	typedef typename std::iterator_traits<Iter>::difference_type difference_type;
+
+	typedef typename std::iterator_traits<Iter>::value_type value_type;
+
+	typedef typename std::iterator_traits<Iter>::pointer pointer;
+	typedef typename std::iterator_traits<Iter>::reference reference;
+
+private: // -- data -- //
+
+	segments_t  segs; // the segments
+	std::size_t seg;  // the index of the current segment
+	Iter        iter; // the current position within the current segment
+
+	// true if we're supposed to be at least a random access iterator
+	static constexpr bool rand_access = std::is_same<iterator_category, std::random_access_iterator_tag>::value;
+	// true if we're supposed to be at least a bidirectional iterator
+	static constexpr bool bidirectional = rand_access || std::is_same<iterator_category, std::bidirectional_iterator_tag>::value;
+
+private: // -- helpers -- //
+
+	// moves past the end of the current segment (and any empty segments after it) unless it's the last segment.
+	constexpr void __skip() { while (seg + 1 < N && iter == segs[seg].second) iter = segs[++seg].first; }
+
+	// returns the number of elements before the current position.
+	constexpr difference_type __pos() const
+	{
+		difference_type pos = iter - segs[seg].first;
+		for (std::size_t i = 0; i < seg; ++i) pos += segs[i].second - segs[i].first;
+		return pos;
+	}
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates a new concat iterator over the given segments at position _iter of the segment with index _seg.
+	constexpr concat_iterator(segments_t _segs, std::size_t _seg, Iter _iter) : segs(std::move(_segs)), seg(_seg), iter(std::move(_iter)) { __skip(); }
+
+public: // -- access -- //
+
+	// returns the value of dereferencing the stored iterator.
+	constexpr decltype(auto) operator*() & { return *iter; }
+	constexpr decltype(auto) operator*() const& { return *iter; }
+	constexpr decltype(auto) operator*() && { return *std::move(iter); }
+
+	// returns the value of using the arrow operator on the stored iterator.
+	constexpr decltype(auto) operator->() const
+	{
+		if constexpr (std::is_pointer<Iter>::value) return iter;
+		else return iter.operator->();
+	}
+
+public: // -- raw access -- //
+
+	// gets the current position within the current segment.
+	constexpr const Iter &get_iter() const& noexcept { return iter; }
+	constexpr Iter get_iter() && noexcept(std::is_nothrow_move_constructible<Iter>::value) { return std::move(iter); }
+
+	// gets the index of the current segment.
+	constexpr std::size_t get_segment() const noexcept { return seg; }
+
+	// gets the segments.
+	constexpr const segments_t &get_segments() const noexcept { return segs; }
+
+public: // -- forward iterator functions -- //
+
+	// moves to the next element, which may be in a later segment
+	constexpr concat_iterator &operator++() { ++iter; __skip(); return *this; }
+	constexpr concat_iterator operator++(int) { concat_iterator cpy(*this); ++*this; return cpy; }
+
+public: // -- bidirectional iterator functions -- //
+
+	// bidirectional - moves to the previous element, which may be in an earlier segment.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && bidirectional, int> = 0>
+	constexpr concat_iterator &operator--() { while (iter == segs[seg].first) iter = segs[--seg].second; --iter; return *this; }
+	// bidirectional - moves to the previous element, which may be in an earlier segment.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && bidirectional, int> = 0>
+	constexpr concat_iterator operator--(int) { concat_iterator cpy(*this); --*this; return cpy; }
+
+public: // -- random access iterator functions -- //
+
+	// random access - returns the element d elements away.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr reference operator[](difference_type d) const { return *(*this + d); }
+
+	// random access - moves d elements, crossing segments as needed.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr concat_iterator &operator+=(difference_type d)
+	{
+		if (d >= 0) for (difference_type avail; seg + 1 < N && d >= (avail = segs[seg].second - iter); d -= avail) iter = segs[++seg].first;
+		else for (difference_type avail; -d > (avail = iter - segs[seg].first); d += avail) iter = segs[--seg].second;
+		iter += d;
+		return *this;
+	}
+	// random access - moves -d elements, crossing segments as needed.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr concat_iterator &operator-=(difference_type d) { return *this += -d; }
+
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend concat_iterator operator+(const concat_iterator &v, difference_type d) { concat_iterator cpy(v); cpy += d; return cpy; }
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend concat_iterator operator+(difference_type d, const concat_iterator &v) { concat_iterator cpy(v); cpy += d; return cpy; }
+
+	// random access - copies the current iterator state, subtracts d from it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend concat_iterator operator-(const concat_iterator &v, difference_type d) { concat_iterator cpy(v); cpy -= d; return cpy; }
+
+	// random access - returns the number of elements between the iterators.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend difference_type operator-(const concat_iterator &a, const concat_iterator &b) { return a.__pos() - b.__pos(); }
+
+	// random access - compares the positions of a and b (segment first, then the stored iterator)
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<(const concat_iterator &a, const concat_iterator &b) { return a.seg < b.seg || (a.seg == b.seg && a.iter < b.iter); }
+	// random access - compares the positions of a and b (segment first, then the stored iterator)
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<=(const concat_iterator &a, const concat_iterator &b) { return !(b < a); }
+	// random access - compares the positions of a and b (segment first, then the stored iterator)
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>(const concat_iterator &a, const concat_iterator &b) { return b < a; }
+	// random access - compares the positions of a and b (segment first, then the stored iterator)
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>=(const concat_iterator &a, const concat_iterator &b) { return !(a < b); }
+
+public: // -- comparison -- //
+
+	// compares the current segments and stored iterators
+	constexpr friend bool operator==(const concat_iterator &a, const concat_iterator &b) { return a.seg == b.seg && a.iter == b.iter; }
+	constexpr friend bool operator!=(const concat_iterator &a, const concat_iterator &b) { return !(a == b); }
+};
+
+// true if Iter is a concat iterator (see concat_iterator)
+template<typename Iter>
+struct is_concat_iterator : std::false_type {};
+template<typename Iter, std::size_t N>
+struct is_concat_iterator<concat_iterator<Iter, N>> : std::true_type {};
+
+// holds the operation counts recorded by probe iterators.
+// a single probe_counts object is shared (by reference) between all the probe iterators of a pipeline stage, including their copies.
+// the counts are atomic, so instrumented ranges can be run with a parallel policy (e.g. par_pool) - the totals then cover every task.
+struct probe_counts
+{
+	std::atomic<std::size_t> increments{ 0 }; // number of ++ (prefix or postfix)
+	std::atomic<std::size_t> decrements{ 0 }; // number of -- (prefix or postfix)
+	std::atomic<std::size_t> advances{ 0 };   // number of +=, -=, +, and - (with a difference) - i.e. random access jumps
+	std::atomic<std::size_t> derefs{ 0 };     // number of *, ->, and []
+	std::atomic<std::size_t> copies{ 0 };     // number of copy constructions/assignments
+	std::atomic<std::size_t> moves{ 0 };      // number of move constructions/assignments
+	std::atomic<std::size_t> calls{ 0 };      // number of mapping function invocations (only recorded for instrumented mapping stages)
+
+	// resets all counts to zero.
+	void reset() noexcept { increments = 0; decrements = 0; advances = 0; derefs = 0; copies = 0; moves = 0; calls = 0; }
+
+	// prints all the counts to the stream on a single line.
+	friend std::ostream &operator<<(std::ostream &ostr, const probe_counts &c)
+	{
+		return ostr << "++ " << c.increments << ", -- " << c.decrements << ", += " << c.advances << ", deref " << c.derefs
+			<< ", copy " << c.copies << ", move " << c.moves << ", calls " << c.calls;
+	}
+};
+
+// wraps a function object and counts its invocations in a probe_counts object.
+// this is used by instrumented mapping stages to record the number of times the mapping function is called.
+template<typename F>
+class probe_func
+{
+private: // -- data -- //
+
+	F             func;   // the wrapped function
+	probe_counts *counts; // the counts to record to
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates a new probe function that wraps f and records to _counts.
+	constexpr probe_func(const F &f, probe_counts &_counts) : func(f), counts(std::addressof(_counts)) {}
+	constexpr probe_func(F &&f, probe_counts &_counts) : func(std::move(f)), counts(std::addressof(_counts)) {}
+
+public: // -- access -- //
+
+	// records the call and then calls the wrapped function with the specified arguments.
+	template<typename ...Args>
+	constexpr decltype(auto) operator()(Args &&...args) { ++counts->calls; return func(std::forward<Args>(args)...); }
+};
+
+// wraps an iterator and records every increment, decrement, random access jump, dereference, copy, and move in a probe_counts object.
+// this has the same iterator category as the wrapped iterator and otherwise behaves identically.
+// it is meant for finding redundant work in pipelines (e.g. algorithms that dereference the same position several times).
+template<typename Iter>
+class probe_iterator
+{
+public: // -- traits -- //
+
+	typedef typename std::iterator_traits<Iter>::iterator_category iterator_category;
+	typedef typename std::iterator_traits<Iter>::difference_type difference_type;
+
+	typedef typename std::iterator_traits<Iter>::value_type value_type;
+
+	typedef typename std::iterator_traits<Iter>::pointer pointer;
+	typedef typename std::iterator_traits<Iter>::reference reference;
+
+private: // -- data -- //
+
+	Iter          iter;   // the stored iterator
+	probe_counts *counts; // the counts to record to
+
+	// true if we're supposed to be at least a random access iterator
+	static constexpr bool rand_access = std::is_same<iterator_category, std::random_access_iterator_tag>::value;
+	// true if we're supposed to be at least a bidirectional iterator
+	static constexpr bool bidirectional = rand_access || std::is_same<iterator_category, std::bidirectional_iterator_tag>::value;
+
+public: // -- ctor / dtor / asgn -- //
+
+	// constructs a new probe iterator that wraps the given iterator and records to _counts.
+	// wrapping an iterator does not count as a copy or move.
+	constexpr probe_iterator(const Iter &_iter, probe_counts &_counts) : iter(_iter), counts(std::addressof(_counts)) {}
+	constexpr probe_iterator(Iter &&_iter, probe_counts &_counts) : iter(std::move(_iter)), counts(std::addressof(_counts)) {}
+
+	// constructs a new probe iterator with a copy of other's stored iterator - records a copy.
+	constexpr probe_iterator(const probe_iterator &other) : iter(other.iter), counts(other.counts) { ++counts->copies; }
+	// constructs a new probe iterator by moving from other's stored iterator - records a move.
+	// the other iterator is left in an undefined but valid state.
+	constexpr probe_iterator(probe_iterator &&other) : iter(std::move(other.iter)), counts(other.counts) { ++counts->moves; }
+
+	// copies other's stored iterator to this iterator - records a copy.
+	constexpr probe_iterator &operator=(const probe_iterator &other) { iter = other.iter; counts = other.counts; ++counts->copies; return *this; }
+	// moves other's stored iterator to this iterator - records a move.
+	// the other iterator is left in an undefined but valid state.
+	constexpr probe_iterator &operator=(probe_iterator &&other) { iter = std::move(other.iter); counts = other.counts; ++counts->moves; return *this; }
+
+public: // -- iter access -- //
+
+	// records a dereference and returns the value of dereferencing the stored iterator.
+	constexpr decltype(auto) operator*() & { ++counts->derefs; return *iter; }
+	constexpr decltype(auto) operator*() const& { ++counts->derefs; return *iter; }
+	constexpr decltype(auto) operator*() && { ++counts->derefs; return *std::move(iter); }
+
+	// records a dereference and returns the value of using the arrow operator on the stored iterator.
+	constexpr decltype(auto) operator->() const&
+	{
+		++counts->derefs;
+		if constexpr (std::is_pointer<Iter>::value) return iter;
+		else return iter.operator->();
+	}
+
+public: // -- raw access -- //
+
+	// gets the current stored iterator for this probe iterator.
+	constexpr const Iter &get_iter() const& noexcept { return iter; }
+	constexpr Iter get_iter() && noexcept(std::is_nothrow_move_constructible<Iter>::value) { return std::move(iter); }
+
+	// gets the counts object this probe iterator records to.
+	constexpr probe_counts &get_counts() const noexcept { return *counts; }
+
+public: // -- forward iterator functions -- //
+
+	// records an increment and increments the stored iterator.
+	constexpr probe_iterator &operator++() { ++counts->increments; ++iter; return *this; }
+	constexpr probe_iterator operator++(int) { probe_iterator cpy(*this); ++*this; return cpy; }
+
+public: // -- bidirectional iterator functions -- //
+
+	// bidirectional - records a decrement and decrements the stored iterator.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && bidirectional, int> = 0>
+	constexpr probe_iterator &operator--() { ++counts->decrements; --iter; return *this; }
+	// bidirectional - records a decrement and decrements the stored iterator.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && bidirectional, int> = 0>
+	constexpr probe_iterator operator--(int) { probe_iterator cpy(*this); --*this; return cpy; }
+
+public: // -- random access iterator functions -- //
+
+	// random access - records a dereference and returns the result of indexing the stored iterator.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr decltype(auto) operator[](difference_type d) { ++counts->derefs; return iter[d]; }
+
+	// random access - records an advance and adds d to the stored iterator.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr probe_iterator &operator+=(difference_type d) { ++counts->advances; iter += d; return *this; }
+	// random access - records an advance and subtracts d from the stored iterator.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr probe_iterator &operator-=(difference_type d) { ++counts->advances; iter -= d; return *this; }
+
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend probe_iterator operator+(const probe_iterator &v, difference_type d) { probe_iterator cpy(v); cpy += d; return cpy; }
+	// random access - copies the current iterator state, adds d to it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend probe_iterator operator+(difference_type d, const probe_iterator &v) { probe_iterator cpy(v); cpy += d; return cpy; }
+
+	// random access - copies the current iterator state, subtracts d from it, and returns the result.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend probe_iterator operator-(const probe_iterator &v, difference_type d) { probe_iterator cpy(v); cpy -= d; return cpy; }
+
+	// random access - returns the difference of the stored iterators.
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend difference_type operator-(const probe_iterator &a, const probe_iterator &b) { return a.iter - b.iter; }
+
+	// random access - returns the result of comparing the stored iterators
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<(const probe_iterator &a, const probe_iterator &b) { return a.iter < b.iter; }
+	// random access - returns the result of comparing the stored iterators
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator<=(const probe_iterator &a, const probe_iterator &b) { return a.iter <= b.iter; }
+	// random access - returns the result of comparing the stored iterators
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>(const probe_iterator &a, const probe_iterator &b) { return a.iter > b.iter; }
+	// random access - returns the result of comparing the stored iterators
+	template<typename _I = Iter, std::enable_if_t<std::is_same<_I, Iter>::value && rand_access, int> = 0>
+	constexpr friend bool operator>=(const probe_iterator &a, const probe_iterator &b) { return a.iter >= b.iter; }
+
+public: // -- comparison -- //
+
+	// compares the stored iterators - comparisons are not recorded
+	constexpr friend bool operator==(const probe_iterator &a, const probe_iterator &b) { return a.iter == b.iter; }
+	constexpr friend bool operator!=(const probe_iterator &a, const probe_iterator &b) { return a.iter != b.iter; }
+};
+
+// given an iterator, creates a probe iterator that records to counts.
+template<typename Iter, std::enable_if_t<!is_sentinel<Iter>::value, int> = 0>
+auto make_probe_iterator(const Iter &iter, probe_counts &counts) { return probe_iterator<Iter>(iter, counts); }
+// given a mapping iterator, creates a probe iterator that records to counts - the mapping function is also wrapped so its invocations are recorded.
+template<typename Iter, typename F>
+auto make_probe_iterator(const mapping_iterator<Iter, F> &iter, probe_counts &counts)
+{
+	typedef mapping_iterator<Iter, probe_func<F>> probed_t;
+	return probe_iterator<probed_t>(probed_t(iter.get_iter(), probe_func<F>(iter.get_func(), counts)), counts);
+}
+// given a sentinel, returns the sentinel itself - sentinels are never dereferenced, so there is nothing to record.
+template<typename Sentinel, std::enable_if_t<is_sentinel<Sentinel>::value, int> = 0>
+constexpr Sentinel make_probe_iterator(const Sentinel &end, probe_counts&) { return end; }
+
+// given the begin probe iterator of a range and its sentinel end, returns an end probe iterator (see sentinel_to_iterator for count iterators).
+template<typename Iter, typename Sentinel>
+constexpr probe_iterator<Iter> sentinel_to_iterator(const probe_iterator<Iter> &begin, const Sentinel &end) { return { sentinel_to_iterator(begin.get_iter(), end), begin.get_counts() }; }
+
+// a persistent pool of worker threads for running the tasks of a parallel algorithm (see pool_policy).
+// the thread calling run() also works on the tasks, so a pool with n workers runs on n + 1 threads.
+class thread_pool
+{
+private: // -- types -- //
+
+	// a call to run() that the workers are helping with
+	struct job_t
+	{
+		void *data;                         // the task function object
+		void (*call)(void*, std::size_t);   // calls the task function object with a task index
+		std::size_t tasks;                  // the number of tasks
+
+		std::atomic<std::size_t> next; // the next task index to hand out
+		std::exception_ptr error;      // the first exception thrown by a task (guarded by the pool mutex)
+
+		job_t(void *_data, void (*_call)(void*, std::size_t), std::size_t _tasks) : data(_data), call(_call), tasks(_tasks), next(0), error() {}
+	};
+
+private: // -- data -- //
+
+	std::vector<std::thread> workers; // the worker threads
+
+	std::mutex              mutex;   // guards everything below
+	std::condition_variable work_cv; // signaled when a job is posted or the pool is stopping
+	std::condition_variable done_cv; // signaled when the last busy worker finishes a job
+
+	job_t      *job = nullptr;  // the current job
+	std::size_t generation = 0; // incremented for every posted job
+	std::size_t busy = 0;       // the number of workers that haven't finished the current job
+	bool        stopping = false;
+
+	std::mutex run_mutex; // serializes calls to run() from different threads
+
+private: // -- helpers -- //
+
+	// true if the current thread is running tasks for some pool - nested parallel calls run serially instead of deadlocking
+	static bool &__in_task() noexcept { thread_local bool flag = false; return flag; }
+
+	// runs tasks from the job until there are none left
+	void __work(job_t &j)
+	{
+		bool prev = __in_task();
+		__in_task() = true;
+		for (std::size_t i; (i = j.next.fetch_add(1)) < j.tasks; )
+		{
+			try { j.call(j.data, i); }
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!j.error) j.error = std::current_exception();
+				j.next = j.tasks; // don't hand out any more tasks
+			}
+		}
+		__in_task() = prev;
+	}
+
+	// the worker thread loop
+	void __worker()
+	{
+		std::size_t seen = 0;
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true)
+		{
+			work_cv.wait(lock, [&] { return stopping || generation != seen; });
+			if (stopping) return;
+			seen = generation;
+
+			job_t *j = job;
+			lock.unlock();
+			__work(*j);
+			lock.lock();
+
+			if (--busy == 0) done_cv.notify_one();
+		}
+	}
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates a pool with the specified number of worker threads (0 runs everything on the calling thread).
+	explicit thread_pool(std::size_t threads)
+	{
+		workers.reserve(threads);
+		for (std::size_t i = 0; i < threads; ++i) workers.emplace_back([this] { __worker(); });
+	}
+
+	// stops and joins all the worker threads
+	~thread_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		work_cv.notify_all();
+		for (std::thread &t : workers) t.join();
+	}
+
+	thread_pool(const thread_pool&) = delete;
+	thread_pool &operator=(const thread_pool&) = delete;
+
+	// returns the shared default pool, which has one worker for each hardware thread besides the caller's.
+	// the pool is created on first use.
+	static thread_pool &get()
+	{
+		static thread_pool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0);
+		return pool;
+	}
+
+public: // -- access -- //
+
+	// returns the number of threads that run tasks (the workers plus the calling thread)
+	std::size_t size() const noexcept { return workers.size() + 1; }
+
+public: // -- execution -- //
+
+	// calls f(i) for every i in [0, tasks) on the pool's threads (including the calling thread) and waits for them all to finish.
+	// if any call throws, no more tasks are started and the first exception is rethrown once the running tasks finish.
+	template<typename F>
+	void run(std::size_t tasks, F &&f)
+	{
+		if (tasks == 0) return;
+		if (workers.empty() || tasks == 1 || __in_task())
+		{
+			for (std::size_t i = 0; i < tasks; ++i) f(i);
+			return;
+		}
+
+		std::lock_guard<std::mutex> run_lock(run_mutex);
+
+		job_t j{ std::addressof(f), [](void *data, std::size_t i) { (*static_cast<std::remove_reference_t<F>*>(data))(i); }, tasks };
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = &j;
+			busy = workers.size();
+			++generation;
+		}
+		work_cv.notify_all();
+
+		__work(j);
+
+		std::unique_lock<std::mutex> lock(mutex);
+		done_cv.wait(lock, [&] { return busy == 0; });
+		job = nullptr;
+		if (j.error) std::rethrow_exception(j.error);
+	}
+};
+
+// an execution policy for the iterator_range algorithms that splits random access ranges into chunks and runs them on a thread_pool.
+// unlike the std execution policies this needs no external threading library (e.g. tbb on libstdc++).
+// algorithms over non-random-access ranges (and the inherently serial ones, e.g. copy_if) run serially on the calling thread.
+// as with std::execution::par, the functions passed to the algorithm must be safe to call concurrently.
+struct pool_policy
+{
+	thread_pool *pool = nullptr;  // the pool to run on (null for thread_pool::get())
+	std::size_t min_chunk = 4096; // the fewest elements to put in a single task
+
+	// returns the pool to run on
+	thread_pool &get_pool() const { return pool ? *pool : thread_pool::get(); }
+
+	// splits [first, last) into contiguous chunks and calls f(chunk_begin, chunk_end) for each of them on the pool.
+	// there are a few more chunks than threads (so uneven chunks balance out) unless that would make them smaller than min_chunk.
+	template<typename RandIt, typename F>
+	void for_each_chunk(const RandIt &first, const RandIt &last, F &&f) const
+	{
+		typedef typename std::iterator_traits<RandIt>::difference_type diff_t;
+
+		diff_t d = last - first;
+		if (d <= 0) return;
+		std::size_t n = (std::size_t)d;
+
+		thread_pool &p = get_pool();
+		std::size_t min = min_chunk > 0 ? min_chunk : 1;
+		std::size_t chunks = std::min((n + min - 1) / min, p.size() * 4);
+
+		p.run(chunks, [&](std::size_t i) { f(first + (diff_t)(n * i / chunks), first + (diff_t)(n * (i + 1) / chunks)); });
+	}
+};
+
+// the default pool_policy - runs on thread_pool::get()
+inline constexpr pool_policy par_pool{};
+
+// combines a sequence of values with a binary operation in a fixed-shape binary tree.
+// the shape only depends on the number of values pushed, so the result is reproducible even for non-associative operations (e.g. floating point addition).
+// values are paired as they arrive (like a binary counter) and the leftover partial trees are combined right-to-left by finish().
+template<typename T, typename BinaryOp>
+class tree_reducer
+{
+private: // -- types -- //
+
+	// the root of a perfect subtree with 2^height leaves
+	struct node_t
+	{
+		T           value;
+		std::size_t height;
+	};
+
+private: // -- data -- //
+
+	std::vector<node_t> stack; // the pending subtrees (heights strictly decreasing)
+	BinaryOp            op;    // the binary operation
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates an empty reducer with the specified binary operation
+	explicit tree_reducer(BinaryOp _op) : op(std::forward<BinaryOp>(_op)) {}
+
+public: // -- reduction -- //
+
+	// returns true if no values have been pushed
+	bool empty() const noexcept { return stack.empty(); }
+
+	// adds the next value to the tree
+	void push(T value)
+	{
+		stack.push_back({ std::move(value), 0 });
+		while (stack.size() >= 2 && stack[stack.size() - 2].height == stack.back().height)
+		{
+			T right = std::move(stack.back().value);
+			stack.pop_back();
+			stack.back().value = op(std::move(stack.back().value), std::move(right));
+			++stack.back().height;
+		}
+	}
+
+	// combines everything pushed so far into a single value and empties the reducer - the reducer must not be empty
+	T finish()
+	{
+		T res = std::move(stack.back().value);
+		stack.pop_back();
+		for (; !stack.empty(); stack.pop_back()) res = op(std::move(stack.back().value), std::move(res));
+		return res;
+	}
+};
+
+// represents an iterator range - stores a begin() and an end() and can by used in range-based for loops
+template<typename IterBegin, typename IterEnd = IterBegin>
+class iterator_range
+{
+private: // -- data -- //
+
+	IterBegin _begin; // the begin iterator
+	IterEnd   _end;   // the end iterator
+
+	template<typename A, typename B> friend class iterator_range;
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates a new iterator range with the specified iterator range.
+	constexpr iterator_range(IterBegin b, IterEnd e) : _begin(std::move(b)), _end(std::move(e)) {}
+
+	// creates a new iterator range that is a copy of other's iterators.
+	constexpr iterator_range(const iterator_range &other) : _begin(other._begin), _end(other._end) {}
+	// creates a new iterator range by move constructing from other's iterators.
+	constexpr iterator_range(iterator_range &&other) : _begin(std::move(other._begin)), _end(std::move(other._end)) {}
+
+	// copy assigns other's iterators to this object.
+	constexpr iterator_range &operator=(const iterator_range &other) { _begin = other._begin; _end = other._end; return *this; }
+	// move assignes other's iterators to this object
+	constexpr iterator_range &operator=(iterator_range &&other) { _begin = std::move(other._begin); _end = std::move(other._end); return *this; }
+
+public: // -- conversion ctor / asgn -- //
+
+	// creates a new iterator range by calling std::begin() and std::end() for the given container.
+	// note that this also enables conversion between iterator_range objects of compatible iterator types.
+	template<typename Container> explicit constexpr iterator_range(Container &container) : _begin(std::begin(container)), _end(std::end(container)) {}
+	// copies the iterator range by calling std::begin() and std::end() for the given container.
+	// note that this also enables conversion between iterator_range objects of compatible iterator types.
+	template<typename Container> constexpr iterator_range &operator=(Container &container) { _begin = std::begin(container); _end = std::end(container); return *this; }
+
+	// move conversion constructor for converting between iterator ranges of compatible types.
+	template<typename OtherIterBegin, typename OtherIterEnd>
+	explicit constexpr iterator_range(iterator_range<OtherIterBegin, OtherIterEnd> &&other) : _begin(std::move(other._begin)), _end(std::move(other._end)) {}
+	// move conversion operator for converting between iterator ranges of compatible types.
+	template<typename OtherIterBegin, typename OtherIterEnd>
+	constexpr iterator_range &operator=(iterator_range<OtherIterBegin, OtherIterEnd> &&other) { _begin = std::move(other._begin); _end = std::move(other._end); return *this; }
+	
+public: // -- range access -- //
+
+	// accesses the stored begin iterator.
+	constexpr IterBegin &begin() & noexcept { return _begin; }
+	constexpr const IterBegin &begin() const& noexcept { return _begin; }
+	constexpr IterBegin begin() && noexcept(std::is_nothrow_move_constructible<IterBegin>::value) { return std::move(_begin); }
+
+	// accesses the stored end iterator.
+	constexpr IterEnd &end() & noexcept { return _end; }
+	constexpr const IterEnd &end() const& noexcept { return _end; }
+	constexpr IterEnd end() && noexcept(std::is_nothrow_move_constructible<IterEnd>::value) { return std::move(_end); }
+
+public: // -- mapping -- //
+
+	// the begin type of a range mapped through F (see fused_mapping).
+	template<typename F>
+	using mapped_begin_t = typename fused_mapping<IterBegin, std::decay_t<F>>::type;
+	// the end type of a range mapped through F - sentinel ends are left as-is since they are never dereferenced.
+	template<typename F>
+	using mapped_end_t = typename std::conditional_t<is_sentinel<IterEnd>::value, std::enable_if<true, IterEnd>, fused_mapping<IterEnd, std::decay_t<F>>>::type;
+
+	// given a mapping function, returns a new iterator range that maps this range through the function.
+	// mapping an already-mapped range composes the functions instead of nesting mapping iterators (see fused_mapping).
+	template<typename F>
+	constexpr auto map(const F &func) const& -> iterator_range<mapped_begin_t<F>, mapped_end_t<F>>
+	{
+		return { fused_mapping<IterBegin, std::decay_t<F>>::make(_begin, func), __map_end(_end, func) };
+	}
+	template<typename F>
+	constexpr auto map(const F &func) && -> iterator_range<mapped_begin_t<F>, mapped_end_t<F>>
+	{
+		return { fused_mapping<IterBegin, std::decay_t<F>>::make(std::move(_begin), func), __map_end(std::move(_end), func) };
+	}
+
+	// the end type of a range mapped through F by map_cached() - sentinel ends are left as-is since they are never dereferenced.
+	template<typename F>
+	using cached_mapped_end_t = std::conditional_t<is_sentinel<IterEnd>::value, IterEnd, cached_mapping_iterator<IterEnd, std::decay_t<F>>>;
+
+	// like map(), but each element's mapped value is computed at most once per position and cached in the iterator (see cached_mapping_iterator).
+	// this is worthwhile for expensive functions under algorithms that dereference the same position more than once (e.g. adjacent_find, search_n).
+	template<typename F>
+	constexpr auto map_cached(const F &func) const& -> iterator_range<cached_mapping_iterator<IterBegin, std::decay_t<F>>, cached_mapped_end_t<F>>
+	{
+		return { { _begin, func }, __map_cached_end(_end, func) };
+	}
+	template<typename F>
+	constexpr auto map_cached(const F &func) && -> iterator_range<cached_mapping_iterator<IterBegin, std::decay_t<F>>, cached_mapped_end_t<F>>
+	{
+		return { { std::move(_begin), func }, __map_cached_end(std::move(_end), func) };
+	}
+
+	// like map(), but the elements are mapped in blocks of N (see block_func) - this lets accumulate(), for_each(), and copy() run as vectorizable loops.
+	// func may either be a block function (std::array<U, N>(const std::array<V, N>&)) or an ordinary mapping function, which is then applied to each lane of the block.
+	template<std::size_t N = 8, typename F>
+	constexpr auto map_blocks(const F &func) const& { return map(block_func_t<IterBegin, N, F>(__make_block_func<N>(func))); }
+	template<std::size_t N = 8, typename F>
+	constexpr auto map_blocks(const F &func) && { return std::move(*this).map(block_func_t<IterBegin, N, F>(__make_block_func<N>(func))); }
+
+public: // -- filtering -- //
+
+	// the begin type of a range filtered by Pred (see filter_iterator).
+	template<typename Pred>
+	using filtered_begin_t = filter_iterator<IterBegin, std::decay_t<Pred>, IterEnd>;
+	// the end type of a range filtered by Pred - sentinel ends become a filter_sentinel, since the filter iterators hold the underlying end.
+	template<typename Pred>
+	using filtered_end_t = std::conditional_t<is_sentinel<IterEnd>::value, filter_sentinel, filtered_begin_t<Pred>>;
+
+	// given a predicate, returns a new iterator range over only the elements of this range that satisfy it.
+	// this is lazy - the predicate is evaluated once per element as the range is traversed, but the first match is found immediately.
+	template<typename Pred>
+	constexpr auto filter(const Pred &pred) const& -> iterator_range<filtered_begin_t<Pred>, filtered_end_t<Pred>>
+	{
+		return { filtered_begin_t<Pred>(_begin, _end, pred), __filter_end(_end, pred) };
+	}
+	template<typename Pred>
+	constexpr auto filter(const Pred &pred) && -> iterator_range<filtered_begin_t<Pred>, filtered_end_t<Pred>>
+	{
+		auto end = __filter_end(_end, pred);
+		return { filtered_begin_t<Pred>(std::move(_begin), std::move(_end), pred), std::move(end) };
+	}
+
+public: // -- striding -- //
+
+	// the iterator type of a strided range (see stride()).
+	typedef stride_iterator<IterBegin, IterEnd> strided_t;
+
+	// returns a new iterator range over every n-th element of this range, starting with the first (n must be positive).
+	// the result is random access if this range is, in which case its end and distance are computed in constant time.
+	// the end is a stride iterator positioned at this range's end (never past it), so sentinel ranges give common ranges here.
+	constexpr iterator_range<strided_t, strided_t> stride(std::ptrdiff_t n) const&
+	{
+		IterBegin last = __common_end(_begin, _end);
+		auto missing = __stride_missing(_begin, last, n);
+		return { strided_t(_begin, _end, n), strided_t(std::move(last), _end, n, missing) };
+	}
+	constexpr iterator_range<strided_t, strided_t> stride(std::ptrdiff_t n) &&
+	{
+		IterBegin last = __common_end(_begin, _end);
+		auto missing = __stride_missing(_begin, last, n);
+		return { strided_t(std::move(_begin), _end, n), strided_t(std::move(last), std::move(_end), n, missing) };
+	}
+
+public: // -- chunking -- //
+
+	// the iterator type of a chunked range (see chunk()).
+	typedef chunk_iterator<IterBegin, IterEnd> chunked_t;
+
+	// returns a new iterator range over the chunks of (up to) n elements of this range (n must be positive) - the last chunk may be partial.
+	// each chunk is an iterator_range<IterBegin, IterBegin> over this range (e.g. a raw pointer span for pointer ranges, which suits vectorized kernels).
+	// the result is random access if this range is, in which case the number of chunks is found in constant time.
+	constexpr iterator_range<chunked_t, chunked_t> chunk(std::ptrdiff_t n) const&
+	{
+		auto strided = stride(n);
+		return { chunked_t(std::move(strided).begin()), chunked_t(std::move(strided).end()) };
+	}
+	constexpr iterator_range<chunked_t, chunked_t> chunk(std::ptrdiff_t n) &&
+	{
+		auto strided = std::move(*this).stride(n);
+		return { chunked_t(std::move(strided).begin()), chunked_t(std::move(strided).end()) };
+	}
+
+public: // -- zipping -- //
+
+	// the iterator type of this range zipped with ranges of type Ranges (see zip()).
+	template<typename ...Ranges>
+	using zipped_t = zip_iterator<IterBegin, std::decay_t<decltype(std::begin(std::declval<Ranges&>()))>...>;
+	// the end type of this range zipped with ranges of type Ranges - sentinel ends are left as-is, since only the first iterator is compared.
+	template<typename ...Ranges>
+	using zipped_end_t = std::conditional_t<is_sentinel<IterEnd>::value, IterEnd, zipped_t<Ranges...>>;
+
+	// returns a new iterator range that walks this range and the other ranges (iterator ranges or containers) in lock step (see zip_iterator).
+	// only this range's end is checked, so the others must be at least as long - the end zip iterator's other iterators are placed
+	// this range's length into their ranges (walking them there if the zip iterator is bidirectional but not random access, so that
+	// walking back from the end stays aligned), and at the ends of their ranges if it is only a forward iterator.
+	// the other ranges are accessed by reference, so containers must outlive the result.
+	template<typename ...Ranges>
+	constexpr auto zip(Ranges &&...others) const& -> iterator_range<zipped_t<Ranges...>, zipped_end_t<Ranges...>>
+	{
+		return { zipped_t<Ranges...>(_begin, std::begin(others)...), __zip_end(_begin, _end, others...) };
+	}
+	template<typename ...Ranges>
+	constexpr auto zip(Ranges &&...others) && -> iterator_range<zipped_t<Ranges...>, zipped_end_t<Ranges...>>
+	{
+		auto end = __zip_end(_begin, std::move(_end), others...);
+		return { zipped_t<Ranges...>(std::move(_begin), std::begin(others)...), std::move(end) };
+	}
+
+public: // -- enumeration -- //
+
+	// returns a new iterator range of (index, value) pairs for this range (see enumerate_iterator) - indices start at 0.
+	// count ranges reuse their count iterators (so indices continue from their current count), other ranges are counted from their begin.
+	// random access ranges get a random access end at the right count - other ranges keep their sentinel end or get an iterator_sentinel.
+	constexpr auto enumerate() const&
+	{
+		typedef typename uncounted<IterBegin>::type iter_t;
+		enumerate_iterator<iter_t> first(__counted(_begin));
+		if constexpr (is_sentinel<IterEnd>::value) return iterator_range<enumerate_iterator<iter_t>, IterEnd>(std::move(first), _end);
+		else if constexpr (!std::is_same<iter_t, IterBegin>::value) return iterator_range<enumerate_iterator<iter_t>, enumerate_iterator<iter_t>>(std::move(first), enumerate_iterator<iter_t>(_end));
+		else if constexpr (__is_rand<IterBegin> && std::is_same<IterBegin, IterEnd>::value)
+		{
+			enumerate_iterator<iter_t> last(count_iterator<IterBegin>(_end, static_cast<typename count_iterator<IterBegin>::count_t>(_end - _begin)));
+			return iterator_range<enumerate_iterator<iter_t>, enumerate_iterator<iter_t>>(std::move(first), std::move(last));
+		}
+		else return iterator_range<enumerate_iterator<iter_t>, iterator_sentinel<IterEnd>>(std::move(first), iterator_sentinel<IterEnd>(_end));
+	}
+
+public: // -- concatenation -- //
+
+	// the iterator type of this range concatenated with Count other ranges (see concat()).
+	template<std::size_t Count>
+	using concat_t = concat_iterator<IterBegin, Count + 1>;
+
+	// returns a new iterator range that walks this range and then each of the other ranges (iterator ranges or containers) in turn (see concat_iterator).
+	// the other ranges' iterators must be convertible to this range's begin iterator type, and sentinel ends are replaced with iterators (see sentinel_to_iterator).
+	// the other ranges are accessed by reference, so containers must outlive the result.
+	template<typename ...Ranges>
+	constexpr auto concat(Ranges &&...others) const& -> iterator_range<concat_t<sizeof...(Ranges)>>
+	{
+		return __concat(typename concat_t<sizeof...(Ranges)>::segments_t{ { { _begin, __common_end(_begin, _end) }, __concat_segment(others)... } });
+	}
+	template<typename ...Ranges>
+	constexpr auto concat(Ranges &&...others) && -> iterator_range<concat_t<sizeof...(Ranges)>>
+	{
+		IterBegin last = __common_end(_begin, std::move(_end));
+		return __concat(typename concat_t<sizeof...(Ranges)>::segments_t{ { { std::move(_begin), std::move(last) }, __concat_segment(others)... } });
+	}
+
+public: // -- instrumentation -- //
+
+	// returns a new iterator range that wraps this range's iterators in probe iterators which record their operations to counts.
+	// if this is a mapped range the mapping function is also wrapped, so counts.calls records its invocations.
+	// instrumenting each stage of a pipeline with a separate probe_counts object gives per-stage counts.
+	constexpr auto instrument(probe_counts &counts) const& -> iterator_range<decltype(make_probe_iterator(_begin, counts)), decltype(make_probe_iterator(_end, counts))>
+	{
+		return { make_probe_iterator(_begin, counts), make_probe_iterator(_end, counts) };
+	}
+
+private: // -- algorithm helpers -- //
+
+	// returns iter as a count iterator for enumerate() - count iterators are used as-is, anything else is counted from 0.
+	template<typename I>
+	static constexpr count_iterator<I> __counted(const I &iter) { return count_iterator<I>(iter, 0); }
+	template<typename I>
+	static constexpr count_iterator<I> __counted(const count_iterator<I> &iter) { return iter; }
+
+	// returns the [begin, end) iterator pair of other as a segment of a concatenated range (see concat()).
+	template<typename Range>
+	static constexpr std::pair<IterBegin, IterBegin> __concat_segment(Range &other)
+	{
+		IterBegin first(std::begin(other));
+		if constexpr (std::is_convertible<decltype(std::end(other)), IterBegin>::value) return { std::move(first), IterBegin(std::end(other)) };
+		else { IterBegin last = __common_end(first, std::end(other)); return { std::move(first), std::move(last) }; }
+	}
+	// returns the range over all of the given segments (see concat()).
+	template<typename Segments>
+	static constexpr auto __concat(const Segments &segs)
+	{
+		typedef concat_iterator<IterBegin, std::tuple_size<Segments>::value> iter_t;
+		return iterator_range<iter_t>(iter_t(segs, 0, segs.front().first), iter_t(segs, segs.size() - 1, segs.back().second));
+	}
+
+	// returns the end of this range zipped with others (see zip()).
+	template<typename ...Ranges>
+	static constexpr zipped_end_t<Ranges...> __zip_end(const IterBegin &first, IterEnd last, Ranges &...others)
+	{
+		if constexpr (is_sentinel<IterEnd>::value) return last;
+		else
+		{
+			constexpr bool bidirectional = std::is_base_of<std::bidirectional_iterator_tag, typename zipped_t<Ranges...>::iterator_category>::value;
+			auto ends = std::make_tuple(__zip_other_end<bidirectional>(first, last, others)...);
+			return std::apply([&](auto &...e) { return zipped_t<Ranges...>(std::move(last), std::move(e)...); }, ends);
+		}
+	}
+	// returns the end of other for the end zip iterator of this range zipped with it (see zip()).
+	// if the zip iterator is bidirectional, this is the position this range's length into other, so the end can be walked back from.
+	template<bool Bidirectional, typename Range>
+	static constexpr auto __zip_other_end(const IterBegin &first, const IterEnd &last, Range &other)
+	{
+		typedef std::decay_t<decltype(std::begin(other))> other_t;
+		if constexpr (__is_rand<IterBegin> && __is_rand<other_t>) return other_t(std::begin(other) + (last - first));
+		else if constexpr (Bidirectional) return other_t(std::next(std::begin(other), __distance(first, last)));
+		else return __common_end(other_t(std::begin(other)), std::end(other));
+	}
+
+	// returns how much of the last step of a stride of n over [first, last) is cut short by the end (see stride()).
+	// only random access stride iterators use this, so it is only computed for them.
+	template<typename B>
+	static constexpr std::ptrdiff_t __stride_missing(const B &first, const B &last, std::ptrdiff_t n)
+	{
+		if constexpr (std::is_same<typename stride_iterator<B, IterEnd>::iterator_category, std::random_access_iterator_tag>::value)
+		{
+			const std::ptrdiff_t rem = static_cast<std::ptrdiff_t>(last - first) % n;
+			return rem == 0 ? 0 : n - rem;
+		}
+		else return 0;
+	}
+
+	// returns the end of this range filtered by pred (see filter()).
+	template<typename Pred>
+	static constexpr filtered_end_t<Pred> __filter_end(const IterEnd &end, const Pred &pred)
+	{
+		if constexpr (is_sentinel<IterEnd>::value) return filter_sentinel{};
+		else return filtered_begin_t<Pred>(end, end, pred);
+	}
+
+	// maps the end of this range through func (see map_cached()).
+	template<typename F>
+	static constexpr cached_mapped_end_t<F> __map_cached_end(IterEnd end, const F &func)
+	{
+		if constexpr (is_sentinel<IterEnd>::value) return end;
+		else return { std::move(end), func };
+	}
+
+	// maps the end of this range through func (see map()).
+	template<typename F>
+	static constexpr mapped_end_t<F> __map_end(IterEnd end, const F &func)
+	{
+		if constexpr (is_sentinel<IterEnd>::value) return end;
+		else return fused_mapping<IterEnd, std::decay_t<F>>::make(std::move(end), func);
+	}
+
+	// returns an end iterator with the same type as the begin iterator - this is end itself unless it's a sentinel (see sentinel_to_iterator).
+	// this is used for algorithms that can't work with sentinels (e.g. parallel or backward algorithms) - for bidirectional ranges ending at
+	// a sentinel, this walks the range to find the end.
+	template<typename B, typename E>
+	static constexpr B __common_end(const B &first, E last)
+	{
+		if constexpr (std::is_same<B, E>::value) return last;
+		else return sentinel_to_iterator(first, last);
+	}
+
+	// creates an overload set - the return type of the function selected by passing nullptr is a type denoting if last - first is valid.
+	template<typename B, typename E>
+	static std::false_type __has_difference(void*);
+	template<typename B, typename E, std::enable_if_t<!std::is_void<decltype(std::declval<const E&>() - std::declval<const B&>())>::value, int> = 0>
+	static std::true_type __has_difference(std::nullptr_t);
+
+	// returns func if it is already a block function for blocks of N source elements, otherwise an elementwise_block_func wrapping it (see map_blocks)
+	template<std::size_t N, typename F>
+	static constexpr auto __make_block_func(const F &func)
+	{
+		if constexpr (std::is_invocable<const F&, const std::array<std::decay_t<decltype(*std::declval<const IterBegin&>())>, N>&>::value) return std::decay_t<F>(func);
+		else return elementwise_block_func<std::decay_t<F>, N>(func);
+	}
+
+	// true if B is a block mapping iterator (see map_blocks) over a random access source, whose ranges the helpers below process a block at a time
+	template<typename B>
+	static constexpr bool __is_block_mapped()
+	{
+		if constexpr (is_block_mapping_iterator<B>::value) return __is_rand<std::decay_t<decltype(std::declval<const B&>().get_iter())>>;
+		else return false;
+	}
+
+	// calls sink(out, n) for each block of the block-mapped range [first, last), where out is the mapped block and n is the number of lanes in the range.
+	// the block function always gets full blocks - the last one is padded with copies of the last source element.
+	template<typename B, typename E, typename Sink>
+	static void __for_each_block(const B &first, const E &last, Sink &&sink)
+	{
+		typedef std::decay_t<decltype(first.get_func())> func_t;
+		constexpr std::size_t N = func_t::block_size;
+
+		const func_t &f = first.get_func();
+		auto it = first.get_iter();
+		const auto stop = __common_end(first, last).get_iter();
+
+		typename func_t::block_t in;
+		for (; stop - it >= (decltype(stop - it))N; it += N)
+		{
+			for (std::size_t i = 0; i < N; ++i) in[i] = it[i];
+			sink(f.block(in), N);
+		}
+		if (std::size_t rem = (std::size_t)(stop - it))
+		{
+			for (std::size_t i = 0; i < N; ++i) in[i] = it[i < rem ? i : rem - 1];
+			sink(f.block(in), rem);
+		}
+	}
+
+	// true if [B, E) is a concatenated range (see concat()), whose ranges the helpers below process a segment at a time
+	template<typename B, typename E>
+	static constexpr bool __is_segmented = is_concat_iterator<B>::value && std::is_same<B, E>::value;
+
+	// calls f(b, e, i) for the part [b, e) of each segment i covered by the concatenated range [first, last), in order.
+	// stops as soon as f returns true - returns true if it did.
+	template<typename B, typename F>
+	static constexpr bool __for_each_segment(const B &first, const B &last, F &&f)
+	{
+		const auto &segs = first.get_segments();
+		const std::size_t lo = first.get_segment(), hi = last.get_segment();
+
+		// a single call site keeps the loop f runs from being inlined once per case (first, middle, and last segments)
+		for (std::size_t i = lo; ; ++i)
+		{
+			const auto &b = i == lo ? first.get_iter() : segs[i].first;
+			const auto &e = i == hi ? last.get_iter() : segs[i].second;
+			if (f(b, e, i)) return true;
+			if (i == hi) return false;
+		}
+	}
+
+	// true if T is an integral type that the closed forms for integral value ranges can handle
+	template<typename T>
+	static constexpr bool __is_closed_form_int = std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= sizeof(std::uint64_t);
+
+	// compares integers of possibly different signedness by value (like std::cmp_less in c++20)
+	template<typename A, typename B>
+	static constexpr bool __int_less(A a, B b) noexcept
+	{
+		if constexpr (std::is_signed<A>::value == std::is_signed<B>::value) return a < b;
+		else if constexpr (std::is_signed<A>::value) return a < 0 || std::make_unsigned_t<A>(a) < b;
+		else return b >= 0 && a < std::make_unsigned_t<B>(b);
+	}
+
+	// returns true if one of the values of the integral value range [lo, hi) compares equal to the integer v with == (as std::find and std::count do),
+	// in which case that value is stored to match. like ==, this compares in the common type of V and T, so e.g. -1 matches 4294967295u -
+	// V converts to the common type without losing values, so the only candidate is v converted to the common type and back to V.
+	template<typename V, typename T>
+	static constexpr bool __int_range_contains(const V &lo, const V &hi, const T &v, V &match) noexcept
+	{
+		typedef std::common_type_t<V, T> common_t;
+		match = static_cast<V>(static_cast<common_t>(v));
+		return static_cast<common_t>(match) == static_cast<common_t>(v) && !(match < lo) && match < hi;
+	}
+
+	// returns the sum of the integral value range [lo, hi) modulo 2^64 (the gauss sum n*lo + n(n-1)/2).
+	// everything is done in 64-bit unsigned arithmetic (halving whichever of n and n-1 is even) so no intermediate step can overflow -
+	// this gives the same result as adding the values one at a time to any integral accumulator of up to 64 bits.
+	template<typename V>
+	static constexpr std::uint64_t __int_range_sum(const V &lo, const V &hi) noexcept
+	{
+		if (!__int_less(lo, hi)) return 0;
+		std::uint64_t n = (std::uint64_t)hi - (std::uint64_t)lo;
+		std::uint64_t tri = n % 2 == 0 ? (n / 2) * (n - 1) : n * ((n - 1) / 2);
+		return n * (std::uint64_t)lo + tri;
+	}
+
+	// the stdlib algorithms require begin and end to have the same type.
+	// integral value ranges (see is_integral_value_range) are arithmetic sequences, so several of these helpers answer them in constant time instead.
+	// these helpers forward to the stdlib when they do, and otherwise (e.g. for sentinel ends) run an equivalent loop.
+
+	template<typename B, typename E>
+	static constexpr typename std::iterator_traits<B>::difference_type __distance(B first, E last)
+	{
+		if constexpr (std::is_same<B, E>::value) return std::distance(std::move(first), std::move(last));
+		else if constexpr (decltype(__has_difference<B, E>(nullptr))::value) return last - first;
+		else { typename std::iterator_traits<B>::difference_type n = 0; for (; first != last; ++first) ++n; return n; }
+	}
+
+	template<typename B, typename E, typename T>
+	static constexpr T __accumulate(B first, E last, T init)
+	{
+		if constexpr (is_integral_value_range<B, E>::value && __is_closed_form_int<T>) return (T)((std::uint64_t)init + __int_range_sum(*first, *last));
+		else if constexpr (__is_block_mapped<B>())
+		{
+			__for_each_block(first, last, [&](const auto &out, std::size_t n) { for (std::size_t i = 0; i < n; ++i) init = std::move(init) + out[i]; });
+			return init;
+		}
+		else if constexpr (__is_segmented<B, E>)
+		{
+			__for_each_segment(first, last, [&](const auto &b, const auto &e, std::size_t) { init = __accumulate(b, e, std::move(init)); return false; });
+			return init;
+		}
+		else if constexpr (std::is_same<B, E>::value) return std::accumulate(std::move(first), std::move(last), std::move(init));
+		else { for (; first != last; ++first) init = std::move(init) + *first; return init; }
+	}
+	template<typename B, typename E, typename T, typename BinaryOperation>
+	static constexpr T __accumulate(B first, E last, T init, BinaryOperation &&op)
+	{
+		if constexpr (__is_block_mapped<B>())
+		{
+			__for_each_block(first, last, [&](const auto &out, std::size_t n) { for (std::size_t i = 0; i < n; ++i) init = op(std::move(init), out[i]); });
+			return init;
+		}
+		else if constexpr (__is_segmented<B, E>)
+		{
+			__for_each_segment(first, last, [&](const auto &b, const auto &e, std::size_t) { init = __accumulate(b, e, std::move(init), op); return false; });
+			return init;
+		}
+		else if constexpr (std::is_same<B, E>::value) return std::accumulate(std::move(first), std::move(last), std::move(init), std::forward<BinaryOperation>(op));
+		else { for (; first != last; ++first) init = op(std::move(init), *first); return init; }
+	}
+
+	template<typename B, typename E, typename UnaryPredicate>
+	static constexpr B __find_if(B first, E last, UnaryPredicate &&p)
+	{
+		if constexpr (__is_segmented<B, E>)
+		{
+			B res = last;
+			__for_each_segment(first, last, [&](const auto &b, const auto &e, std::size_t i) { auto it = __find_if(b, e, p); if (it == e) return false; res = B(first.get_segments(), i, std::move(it)); return true; });
+			return res;
+		}
+		else if constexpr (std::is_same<B, E>::value) return std::find_if(std::move(first), std::move(last), std::forward<UnaryPredicate>(p));
+		else { for (; first != last; ++first) if (p(*first)) break; return first; }
+	}
+	template<typename B, typename E, typename UnaryPredicate>
+	static constexpr B __find_if_not(B first, E last, UnaryPredicate &&p)
+	{
+		if constexpr (std::is_same<B, E>::value) return std::find_if_not(std::move(first), std::move(last), std::forward<UnaryPredicate>(p));
+		else { for (; first != last; ++first) if (!p(*first)) break; return first; }
+	}
+	template<typename B, typename E, typename T>
+	static constexpr B __find(B first, E last, const T &value)
+	{
+		if constexpr (is_integral_value_range<B, E>::value && __is_closed_form_int<T>)
+		{
+			typename std::iterator_traits<B>::value_type match{};
+			return __int_range_contains(*first, *last, value, match) ? B(match) : last;
+		}
+		else if constexpr (__is_segmented<B, E>)
+		{
+			B res = last;
+			__for_each_segment(first, last, [&](const auto &b, const auto &e, std::size_t i) { auto it = __find(b, e, value); if (it == e) return false; res = B(first.get_segments(), i, std::move(it)); return true; });
+			return res;
+		}
+		else if constexpr (std::is_same<B, E>::value) return std::find(std::move(first), std::move(last), value);
+		else { for (; first != last; ++first) if (*first == value) break; return first; }
+	}
+
+	template<typename B, typename E, typename UnaryPredicate>
+	static constexpr bool __all_of(B first, E last, UnaryPredicate &&p)
+	{
+		if constexpr (std::is_same<B, E>::value) return std::all_of(std::move(first), std::move(last), std::forward<UnaryPredicate>(p));
+		else return __find_if_not(std::move(first), last, p) == last;
+	}
+	template<typename B, typename E, typename UnaryPredicate>
+	static constexpr bool __any_of(B first, E last, UnaryPredicate &&p)
+	{
+		if constexpr (std::is_same<B, E>::value) return std::any_of(std::move(first), std::move(last), std::forward<UnaryPredicate>(p));
+		else return __find_if(std::move(first), last, p) != last;
+	}
+	template<typename B, typename E, typename UnaryPredicate>
+	static constexpr bool __none_of(B first, E last, UnaryPredicate &&p)
+	{
+		if constexpr (std::is_same<B, E>::value) return std::none_of(std::move(first), std::move(last), std::forward<UnaryPredicate>(p));
+		else return __find_if(std::move(first), last, p) == last;
+	}
+
+	template<typename B, typename E, typename UnaryFunction>
+	static constexpr std::decay_t<UnaryFunction> __for_each(B first, E last, UnaryFunction &&f)
+	{
+		if constexpr (__is_block_mapped<B>())
+		{
+			std::decay_t<UnaryFunction> func(std::forward<UnaryFunction>(f));
+			__for_each_block(first, last, [&](const auto &out, std::size_t n) { for (std::size_t i = 0; i < n; ++i) func(out[i]); });
+			return func;
+		}
+		else if constexpr (__is_segmented<B, E>)
+		{
+			std::decay_t<UnaryFunction> func(std::forward<UnaryFunction>(f));
+			__for_each_segment(first, last, [&](const auto &b, const auto &e, std::size_t) { __for_each(b, e, std::ref(func)); return false; });
+			return func;
+		}
+		else if constexpr (std::is_same<B, E>::value) return std::for_each(std::move(first), std::move(last), std::forward<UnaryFunction>(f));
+		else { std::decay_t<UnaryFunction> func(std::forward<UnaryFunction>(f)); for (; first != last; ++first) func(*first); return func; }
+	}
+
+	template<typename B, typename E, typename UnaryPredicate>
+	static constexpr typename std::iterator_traits<B>::difference_type __count_if(B first, E last, UnaryPredicate &&p)
+	{
+		if constexpr (__is_segmented<B, E>)
+		{
+			typename std::iterator_traits<B>::difference_type n = 0;
+			__for_each_segment(first, last, [&](const auto &b, const auto &e, std::size_t) { n += __count_if(b, e, p); return false; });
+			return n;
+		}
+		else if constexpr (std::is_same<B, E>::value) return std::count_if(std::move(first), std::move(last), std::forward<UnaryPredicate>(p));
+		else { typename std::iterator_traits<B>::difference_type n = 0; for (; first != last; ++first) if (p(*first)) ++n; return n; }
+	}
+	template<typename B, typename E, typename T>
+	static constexpr typename std::iterator_traits<B>::difference_type __count(B first, E last, const T &value)
+	{
+		if constexpr (is_integral_value_range<B, E>::value && __is_closed_form_int<T>)
+		{
+			typename std::iterator_traits<B>::value_type match{};
+			return __int_range_contains(*first, *last, value, match) ? 1 : 0;
+		}
+		else if constexpr (__is_segmented<B, E>)
+		{
+			typename std::iterator_traits<B>::difference_type n = 0;
+			__for_each_segment(first, last, [&](const auto &b, const auto &e, std::size_t) { n += __count(b, e, value); return false; });
+			return n;
+		}
+		else if constexpr (std::is_same<B, E>::value) return std::count(std::move(first), std::move(last), value);
+		else { typename std::iterator_traits<B>::difference_type n = 0; for (; first != last; ++first) if (*first == value) ++n; return n; }
+	}
+
+	template<typename B, typename E, typename BinaryPredicate>
+	static constexpr B __adjacent_find(B first, E last, BinaryPredicate &&p)
+	{
+		// the stdlib passes iterators to its predicate wrappers by value, which would fill (and discard) the cache of a copy - so cached iterators use the loop below
+		if constexpr (std::is_same<B, E>::value && !is_cached_mapping_iterator<B>::value) return std::adjacent_find(std::move(first), std::move(last), std::forward<BinaryPredicate>(p));
+		else
+		{
+			if (first == last) return first;
+			B next = first;
+			while (++next != last) { if (p(*first, *next)) return first; first = next; }
+			return next;
+		}
+	}
+	template<typename B, typename E>
+	static constexpr B __adjacent_find(B first, E last)
+	{
+		// consecutive values of an integral value range are never equal
+		if constexpr (is_integral_value_range<B, E>::value) return last;
+		else return __adjacent_find(std::move(first), std::move(last), std::equal_to<>{});
+	}
+
+	template<typename B, typename E, typename Size, typename T, typename BinaryPredicate>
+	static constexpr B __search_n(B first, E last, Size count, const T &value, BinaryPredicate &&p)
+	{
+		// as for __adjacent_find, cached iterators use the loop below so their cache isn't filled on discarded copies
+		if constexpr (std::is_same<B, E>::value && !is_cached_mapping_iterator<B>::value) return std::search_n(std::move(first), std::move(last), count, value, std::forward<BinaryPredicate>(p));
+		else
+		{
+			if (count <= 0) return first;
+			for (; first != last; ++first)
+			{
+				if (!p(*first, value)) continue;
+				B start = first;
+				for (Size n = 1; ; ++n)
+				{
+					if (n >= count) return start;
+					if (++first == last) return first;
+					if (!p(*first, value)) break;
+				}
+			}
+			return first;
+		}
+	}
+	template<typename B, typename E, typename Size, typename T>
+	static constexpr B __search_n(B first, E last, Size count, const T &value)
+	{
+		// each value of an integral value range occurs at most once
+		if constexpr (is_integral_value_range<B, E>::value && __is_closed_form_int<T>) return count <= 0 ? first : count == 1 ? __find(std::move(first), std::move(last), value) : last;
+		else return __search_n(std::move(first), std::move(last), count, value, std::equal_to<>{});
+	}
+
+	template<typename B, typename E, typename OutputIt>
+	static constexpr OutputIt __copy(B first, E last, OutputIt dest)
+	{
+		if constexpr (__is_block_mapped<B>())
+		{
+			__for_each_block(first, last, [&](const auto &out, std::size_t n) { for (std::size_t i = 0; i < n; ++i, ++dest) *dest = out[i]; });
+			return dest;
+		}
+		else if constexpr (__is_segmented<B, E>)
+		{
+			__for_each_segment(first, last, [&](const auto &b, const auto &e, std::size_t) { dest = __copy(b, e, std::move(dest)); return false; });
+			return dest;
+		}
+		else if constexpr (std::is_same<B, E>::value) return std::copy(std::move(first), std::move(last), std::move(dest));
+		else { for (; first != last; ++first, ++dest) *dest = *first; return dest; }
+	}
+	template<typename B, typename E, typename OutputIt, typename UnaryPredicate>
+	static constexpr OutputIt __copy_if(B first, E last, OutputIt dest, UnaryPredicate &&p)
+	{
+		if constexpr (std::is_same<B, E>::value) return std::copy_if(std::move(first), std::move(last), std::move(dest), std::forward<UnaryPredicate>(p));
+		else { for (; first != last; ++first) if (p(*first)) { *dest = *first; ++dest; } return dest; }
+	}
+	template<typename B, typename E, typename OutputIt>
+	static constexpr OutputIt __move(B first, E last, OutputIt dest)
+	{
+		if constexpr (std::is_same<B, E>::value) return std::move(std::move(first), std::move(last), std::move(dest));
+		else { for (; first != last; ++first, ++dest) *dest = std::move(*first); return dest; }
+	}
+	template<typename B, typename E, typename T>
+	static constexpr void __fill(B first, E last, const T &value)
+	{
+		if constexpr (std::is_same<B, E>::value) std::fill(std::move(first), std::move(last), value);
+		else for (; first != last; ++first) *first = value;
+	}
+
+private: // -- parallel algorithm helpers -- //
+
+	// true if Policy is a pool_policy, which is handled by these helpers (other policies are forwarded to the stdlib)
+	template<typename Policy>
+	static constexpr bool __is_pool_policy = std::is_same<std::decay_t<Policy>, pool_policy>::value;
+	// true if Iter is a random access iterator (and so can be split into chunks for a pool_policy)
+	template<typename Iter>
+	static constexpr bool __is_rand = std::is_same<typename std::iterator_traits<Iter>::iterator_category, std::random_access_iterator_tag>::value;
+
+	// these helpers take a begin and end of the same type (see __common_end).
+	// with a pool_policy, random access ranges are split into chunks that each run the serial algorithm on the pool, and other ranges run serially.
+
+	template<typename Policy, typename B, typename UnaryPredicate>
+	static B __par_find_if(Policy &&policy, B first, B last, UnaryPredicate &&p)
+	{
+		if constexpr (!__is_pool_policy<Policy>) return std::find_if(std::forward<Policy>(policy), std::move(first), std::move(last), std::forward<UnaryPredicate>(p));
+		else if constexpr (!__is_rand<B>) return std::find_if(std::move(first), std::move(last), p);
+		else
+		{
+			typedef typename std::iterator_traits<B>::difference_type diff_t;
+
+			// the offset of the first match found so far - chunks starting past it are skipped
+			const diff_t n = last - first;
+			std::atomic<diff_t> found(n);
+
+			policy.for_each_chunk(first, last, [&](const B &b, const B &e)
+			{
+				diff_t offset = b - first;
+				if (offset >= found.load(std::memory_order_relaxed)) return;
+				B r = std::find_if(b, e, p);
+				if (r == e) return;
+				diff_t pos = offset + (diff_t)(r - b);
+				for (diff_t cur = found.load(); pos < cur && !found.compare_exchange_weak(cur, pos); );
+			});
+
+			diff_t pos = found.load();
+			return pos == n ? last : first + pos;
+		}
+	}
+	template<typename Policy, typename B, typename UnaryPredicate>
+	static B __par_find_if_not(Policy &&policy, B first, B last, UnaryPredicate &&p)
+	{
+		if constexpr (!__is_pool_policy<Policy>) return std::find_if_not(std::forward<Policy>(policy), std::move(first), std::move(last), std::forward<UnaryPredicate>(p));
+		else return __par_find_if(policy, std::move(first), std::move(last), [&p](auto &&v) { return !p(std::forward<decltype(v)>(v)); });
+	}
+	template<typename Policy, typename B, typename T>
+	static B __par_find(Policy &&policy, B first, B last, const T &value)
+	{
+		if constexpr (!__is_pool_policy<Policy>) return std::find(std::forward<Policy>(policy), std::move(first), std::move(last), value);
+		else return __par_find_if(policy, std::move(first), std::move(last), [&value](const auto &v) { return v == value; });
+	}
+
+	template<typename Policy, typename B, typename UnaryPredicate>
+	static bool __par_all_of(Policy &&policy, B first, B last, UnaryPredicate &&p)
+	{
+		if constexpr (!__is_pool_policy<Policy>) return std::all_of(std::forward<Policy>(policy), std::move(first), std::move(last), std::forward<UnaryPredicate>(p));
+		else return __par_find_if_not(policy, std::move(first), last, p) == last;
+	}
+	template<typename Policy, typename B, typename UnaryPredicate>
+	static bool __par_any_of(Policy &&policy, B first, B last, UnaryPredicate &&p)
+	{
+		if constexpr (!__is_pool_policy<Policy>) return std::any_of(std::forward<Policy>(policy), std::move(first), std::move(last), std::forward<UnaryPredicate>(p));
+		else return __par_find_if(policy, std::move(first), last, p) != last;
+	}
+	template<typename Policy, typename B, typename UnaryPredicate>
+	static bool __par_none_of(Policy &&policy, B first, B last, UnaryPredicate &&p)
+	{
+		if constexpr (!__is_pool_policy<Policy>) return std::none_of(std::forward<Policy>(policy), std::move(first), std::move(last), std::forward<UnaryPredicate>(p));
+		else return __par_find_if(policy, std::move(first), last, p) == last;
+	}
+
+	template<typename Policy, typename B, typename UnaryFunction>
+	static void __par_for_each(Policy &&policy, B first, B last, UnaryFunction &&f)
+	{
+		if constexpr (!__is_pool_policy<Policy>) std::for_each(std::forward<Policy>(policy), std::move(first), std::move(last), std::forward<UnaryFunction>(f));
+		else if constexpr (!__is_rand<B>) for (; first != last; ++first) f(*first);
+		else policy.for_each_chunk(first, last, [&f](B b, const B &e) { for (; b != e; ++b) f(*b); });
+	}
+
+	template<typename Policy, typename B, typename UnaryPredicate>
+	static typename std::iterator_traits<B>::difference_type __par_count_if(Policy &&policy, B first, B last, UnaryPredicate &&p)
+	{
+		if constexpr (!__is_pool_policy<Policy>) return std::count_if(std::forward<Policy>(policy), std::move(first), std::move(last), std::forward<UnaryPredicate>(p));
+		else if constexpr (!__is_rand<B>) return std::count_if(std::move(first), std::move(last), p);
+		else
+		{
+			std::atomic<typename std::iterator_traits<B>::difference_type> total(0);
+			policy.for_each_chunk(first, last, [&](const B &b, const B &e) { total += std::count_if(b, e, p); });
+			return total.load();
+		}
+	}
+	template<typename Policy, typename B, typename T>
+	static typename std::iterator_traits<B>::difference_type __par_count(Policy &&policy, B first, B last, const T &value)
+	{
+		if constexpr (!__is_pool_policy<Policy>) return std::count(std::forward<Policy>(policy), std::move(first), std::move(last), value);
+		else if constexpr (!__is_rand<B>) return std::count(std::move(first), std::move(last), value);
+		else
+		{
+			std::atomic<typename std::iterator_traits<B>::difference_type> total(0);
+			policy.for_each_chunk(first, last, [&](const B &b, const B &e) { total += std::count(b, e, value); });
+			return total.load();
+		}
+	}
+
+	// the output chunks are only independent if the destination is random access too - otherwise these run serially.
+	template<typename Policy, typename B, typename OutputIt>
+	static OutputIt __par_copy(Policy &&policy, B first, B last, OutputIt dest)
+	{
+		if constexpr (!__is_pool_policy<Policy>) return std::copy(std::forward<Policy>(policy), std::move(first), std::move(last), std::move(dest));
+		else if constexpr (!__is_rand<B> || !__is_rand<OutputIt>) return std::copy(std::move(first), std::move(last), std::move(dest));
+		else
+		{
+			policy.for_each_chunk(first, last, [&](const B &b, const B &e) { std::copy(b, e, dest + (b - first)); });
+			return dest + (last - first);
+		}
+	}
+	template<typename Policy, typename B, typename OutputIt>
+	static OutputIt __par_move(Policy &&policy, B first, B last, OutputIt dest)
+	{
+		if constexpr (!__is_pool_policy<Policy>) return std::move(std::forward<Policy>(policy), std::move(first), std::move(last), std::move(dest));
+		else if constexpr (!__is_rand<B> || !__is_rand<OutputIt>) return std::move(std::move(first), std::move(last), std::move(dest));
+		else
+		{
+			policy.for_each_chunk(first, last, [&](const B &b, const B &e) { std::move(b, e, dest + (b - first)); });
+			return dest + (last - first);
+		}
+	}
+	template<typename Policy, typename B, typename T>
+	static void __par_fill(Policy &&policy, B first, B last, const T &value)
+	{
+		if constexpr (!__is_pool_policy<Policy>) std::fill(std::forward<Policy>(policy), std::move(first), std::move(last), value);
+		else if constexpr (!__is_rand<B>) std::fill(std::move(first), std::move(last), value);
+		else policy.for_each_chunk(first, last, [&](const B &b, const B &e) { std::fill(b, e, value); });
+	}
+
+	// these depend on the results for earlier elements, so they always run serially with a pool_policy.
+	template<typename Policy, typename B, typename OutputIt, typename UnaryPredicate>
+	static OutputIt __par_copy_if(Policy &&policy, B first, B last, OutputIt dest, UnaryPredicate &&p)
+	{
+		if constexpr (!__is_pool_policy<Policy>) return std::copy_if(std::forward<Policy>(policy), std::move(first), std::move(last), std::move(dest), std::forward<UnaryPredicate>(p));
+		else return std::copy_if(std::move(first), std::move(last), std::move(dest), std::forward<UnaryPredicate>(p));
+	}
+	template<typename Policy, typename B, typename Size, typename T, typename ...BinaryPredicate>
+	static B __par_search_n(Policy &&policy, B first, B last, Size count, const T &value, BinaryPredicate &&...p)
+	{
+		if constexpr (!__is_pool_policy<Policy>) return std::search_n(std::forward<Policy>(policy), std::move(first), std::move(last), count, value, std::forward<BinaryPredicate>(p)...);
+		else return std::search_n(std::move(first), std::move(last), count, value, std::forward<BinaryPredicate>(p)...);
+	}
+
+private: // -- reduction helpers -- //
+
+	// the number of consecutive elements reduce() folds left-to-right before adding the result to the tree (see tree_reducer)
+	static constexpr std::size_t __reduce_leaf_size = 1024;
+
+	// creates an overload set - the return type of the function selected by passing nullptr is a type denoting if op(v, v) is valid for an F op and a T v.
+	// this tells reduce(init, op) apart from reduce(policy, init).
+	template<typename F, typename T>
+	static std::false_type __is_binary_op(void*);
+	template<typename F, typename T, std::enable_if_t<!std::is_void<decltype(std::declval<F&>()(std::declval<std::decay_t<T>>(), std::declval<std::decay_t<T>>()))>::value, int> = 0>
+	static std::true_type __is_binary_op(std::nullptr_t);
+
+	// folds the next (up to) __reduce_leaf_size elements starting at first (which must not be last) and advances first past them
+	template<typename T, typename B, typename E, typename R, typename X>
+	static T __reduce_leaf(B &first, const E &last, R &reduce_op, X &transform_op)
+	{
+		T acc = transform_op(*first);
+		++first;
+		if constexpr (__is_rand<B> && std::is_same<B, E>::value)
+		{
+			// compute the end of the leaf up front so the loop has a single exit condition
+			auto len = last - first;
+			B stop = len < (decltype(len))__reduce_leaf_size ? last : first + (decltype(len))(__reduce_leaf_size - 1);
+			for (; first != stop; ++first) acc = reduce_op(std::move(acc), transform_op(*first));
+		}
+		else for (std::size_t i = 1; i < __reduce_leaf_size && first != last; ++i, ++first) acc = reduce_op(std::move(acc), transform_op(*first));
+		return acc;
+	}
+
+	// the implementation of reduce() and transform_reduce().
+	// the leaves are computed in parallel for a pool_policy over a random access range and serially otherwise - the tree is the same either way.
+	template<typename Policy, typename T, typename R, typename X>
+	T __tree_reduce(const Policy &policy, T init, R &reduce_op, X &transform_op) const
+	{
+		tree_reducer<T, R&> tree(reduce_op);
+
+		if constexpr (__is_pool_policy<Policy> && __is_rand<IterBegin>)
+		{
+			IterBegin last = __common_end(_begin, _end);
+			auto n = last - _begin;
+			if (n <= 0) return init;
+
+			std::size_t leaves = ((std::size_t)n + __reduce_leaf_size - 1) / __reduce_leaf_size;
+			std::vector<T> partials(leaves, init);
+
+			thread_pool &pool = policy.get_pool();
+			std::size_t min_leaves = policy.min_chunk > __reduce_leaf_size ? policy.min_chunk / __reduce_leaf_size : 1;
+			std::size_t tasks = std::min((leaves + min_leaves - 1) / min_leaves, pool.size() * 4);
+
+			pool.run(tasks, [&](std::size_t t)
+			{
+				for (std::size_t i = leaves * t / tasks, stop = leaves * (t + 1) / tasks; i < stop; ++i)
+				{
+					IterBegin b = _begin + (decltype(n))(i * __reduce_leaf_size);
+					partials[i] = __reduce_leaf<T>(b, last, reduce_op, transform_op);
+				}
+			});
+
+			for (T &v : partials) tree.push(std::move(v));
+		}
+		else
+		{
+			(void)policy;
+			if constexpr (__is_rand<IterBegin>)
+			{
+				IterBegin last = __common_end(_begin, _end);
+				for (IterBegin b = _begin; b != last; ) tree.push(__reduce_leaf<T>(b, last, reduce_op, transform_op));
+			}
+			else for (IterBegin b = _begin; b != _end; ) tree.push(__reduce_leaf<T>(b, _end, reduce_op, transform_op));
+		}
+
+		return tree.empty() ? init : reduce_op(std::move(init), tree.finish());
+	}
+
+public: // -- stdlib predicate/search wrappers -- //
+
+	// equivalent to std::distance() using this range as input.
+	constexpr decltype(auto) distance() const& { return __distance(_begin, _end); }
+	constexpr decltype(auto) distance() && { return __distance(std::move(_begin), std::move(_end)); }
+
+	// equivalent to std::accumulate() using this range as input.
+	template<typename T> std::decay_t<T> accumulate(T &&init) const& { return __accumulate(_begin, _end, std::decay_t<T>(std::forward<T>(init))); }
+	template<typename T> std::decay_t<T> accumulate(T &&init) && { return __accumulate(std::move(_begin), std::move(_end), std::decay_t<T>(std::forward<T>(init))); }
+
+	// equivalent to std::accumulate() using this range as input.
+	template<typename T, typename BinaryOperation>
+	std::decay_t<T> accumulate(T &&init, BinaryOperation &&op) const& { return __accumulate(_begin, _end, std::decay_t<T>(std::forward<T>(init)), std::forward<BinaryOperation>(op)); }
+	template<typename T, typename BinaryOperation>
+	std::decay_t<T> accumulate(T &&init, BinaryOperation &&op) && { return __accumulate(std::move(_begin), std::move(_end), std::decay_t<T>(std::forward<T>(init)), std::forward<BinaryOperation>(op)); }
+
+	// equivalent to std::reduce() using this range as input, except that the elements are always combined in the same fixed-shape tree:
+	// consecutive runs of elements are folded left-to-right and the results are combined pairwise (see tree_reducer).
+	// the shape doesn't depend on the policy or thread count, so results are bit-identical even for non-associative operations (e.g. floating point).
+	// only pool_policy runs in parallel - any other policy is accepted but runs serially.
+	// integral value ranges with an integral init are summed in constant time (see accumulate()).
+	template<typename T>
+	std::decay_t<T> reduce(T &&init) const
+	{
+		if constexpr (is_integral_value_range<IterBegin, IterEnd>::value && __is_closed_form_int<std::decay_t<T>>) return accumulate(std::forward<T>(init));
+		else return transform_reduce(std::forward<T>(init), std::plus<>{}, [](auto &&v) -> decltype(auto) { return std::forward<decltype(v)>(v); });
+	}
+	template<typename T, typename BinaryOp, std::enable_if_t<decltype(__is_binary_op<BinaryOp, T>(nullptr))::value, int> = 0>
+	std::decay_t<T> reduce(T &&init, BinaryOp &&op) const { return transform_reduce(std::forward<T>(init), op, [](auto &&v) -> decltype(auto) { return std::forward<decltype(v)>(v); }); }
+
+	// equivalent to reduce() but with a specified execution policy
+	template<typename Policy, typename T, std::enable_if_t<!decltype(__is_binary_op<T, Policy>(nullptr))::value, int> = 0>
+	std::decay_t<T> reduce(Policy &&policy, T &&init) const
+	{
+		if constexpr (is_integral_value_range<IterBegin, IterEnd>::value && __is_closed_form_int<std::decay_t<T>>) return accumulate(std::forward<T>(init));
+		else return transform_reduce(policy, std::forward<T>(init), std::plus<>{}, [](auto &&v) -> decltype(auto) { return std::forward<decltype(v)>(v); });
+	}
+	template<typename Policy, typename T, typename BinaryOp>
+	std::decay_t<T> reduce(Policy &&policy, T &&init, BinaryOp &&op) const { return transform_reduce(policy, std::forward<T>(init), op, [](auto &&v) -> decltype(auto) { return std::forward<decltype(v)>(v); }); }
+
+	// equivalent to std::transform_reduce() using this range as input, with the same fixed-shape tree as reduce().
+	template<typename T, typename BinaryOp, typename UnaryOp>
+	std::decay_t<T> transform_reduce(T &&init, BinaryOp &&reduce_op, UnaryOp &&transform_op) const { return __tree_reduce(nullptr, std::decay_t<T>(std::forward<T>(init)), reduce_op, transform_op); }
+
+	// equivalent to transform_reduce() but with a specified execution policy
+	template<typename Policy, typename T, typename BinaryOp, typename UnaryOp>
+	std::decay_t<T> transform_reduce(Policy &&policy, T &&init, BinaryOp &&reduce_op, UnaryOp &&transform_op) const { return __tree_reduce(policy, std::decay_t<T>(std::forward<T>(init)), reduce_op, transform_op); }
+
+	// equivalent to std::all_of() using this range as input.
+	template<typename UnaryPredicate>
+	constexpr bool all_of(UnaryPredicate &&p) const& { return __all_of(_begin, _end, std::forward<UnaryPredicate>(p)); }
+	template<typename UnaryPredicate>
+	constexpr bool all_of(UnaryPredicate &&p) && { return __all_of(std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
+
+	// equivalent to std::any_of() using this range as input.
 	template<typename UnaryPredicate>
-	constexpr bool any_of(UnaryPredicate &&p) const& { return std::any_of(_begin, _end, std::forward<UnaryPredicate>(p)); }
+	constexpr bool any_of(UnaryPredicate &&p) const& { return __any_of(_begin, _end, std::forward<UnaryPredicate>(p)); }
 	template<typename UnaryPredicate>
-	constexpr bool any_of(UnaryPredicate &&p) && { return std::any_of(std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
+	constexpr bool any_of(UnaryPredicate &&p) && { return __any_of(std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
 
 	// equivalent to std::none_of() using this range as input.
 	template<typename UnaryPredicate>
-	constexpr bool none_of(UnaryPredicate &&p) const& { return std::none_of(_begin, _end, std::forward<UnaryPredicate>(p)); }
+	constexpr bool none_of(UnaryPredicate &&p) const& { return __none_of(_begin, _end, std::forward<UnaryPredicate>(p)); }
 	template<typename UnaryPredicate>
-	constexpr bool none_of(UnaryPredicate &&p) && { return std::none_of(std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
+	constexpr bool none_of(UnaryPredicate &&p) && { return __none_of(std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
 
 	// equivalent to std::all_of() using this range as input.
 	template<typename Policy, typename UnaryPredicate>
-	constexpr bool all_of(Policy &&policy, UnaryPredicate &&p) const& { return std::all_of(std::forward<Policy>(policy), _begin, _end, std::forward<UnaryPredicate>(p)); }
+	constexpr bool all_of(Policy &&policy, UnaryPredicate &&p) const& { return __par_all_of(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), std::forward<UnaryPredicate>(p)); }
 	template<typename Policy, typename UnaryPredicate>
-	constexpr bool all_of(Policy &&policy, UnaryPredicate &&p) && { return std::all_of(std::forward<Policy>(policy), std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
+	constexpr bool all_of(Policy &&policy, UnaryPredicate &&p) && { auto e = __common_end(_begin, std::move(_end)); return __par_all_of(std::forward<Policy>(policy), std::move(_begin), std::move(e), std::forward<UnaryPredicate>(p)); }
 
 	// equivalent to std::any_of() using this range as input.
 	template<typename Policy, typename UnaryPredicate>
-	constexpr bool any_of(Policy &&policy, UnaryPredicate &&p) const& { return std::any_of(std::forward<Policy>(policy), _begin, _end, std::forward<UnaryPredicate>(p)); }
+	constexpr bool any_of(Policy &&policy, UnaryPredicate &&p) const& { return __par_any_of(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), std::forward<UnaryPredicate>(p)); }
 	template<typename Policy, typename UnaryPredicate>
-	constexpr bool any_of(Policy &&policy, UnaryPredicate &&p) && { return std::any_of(std::forward<Policy>(policy), std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
+	constexpr bool any_of(Policy &&policy, UnaryPredicate &&p) && { auto e = __common_end(_begin, std::move(_end)); return __par_any_of(std::forward<Policy>(policy), std::move(_begin), std::move(e), std::forward<UnaryPredicate>(p)); }
 
 	// equivalent to std::none_of() using this range as input.
 	template<typename Policy, typename UnaryPredicate>
-	constexpr bool none_of(Policy &&policy, UnaryPredicate &&p) const& { return std::none_of(std::forward<Policy>(policy), _begin, _end, std::forward<UnaryPredicate>(p)); }
+	constexpr bool none_of(Policy &&policy, UnaryPredicate &&p) const& { return __par_none_of(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), std::forward<UnaryPredicate>(p)); }
 	template<typename Policy, typename UnaryPredicate>
-	constexpr bool none_of(Policy &&policy, UnaryPredicate &&p) && { return std::none_of(std::forward<Policy>(policy), std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
+	constexpr bool none_of(Policy &&policy, UnaryPredicate &&p) && { auto e = __common_end(_begin, std::move(_end)); return __par_none_of(std::forward<Policy>(policy), std::move(_begin), std::move(e), std::forward<UnaryPredicate>(p)); }
 
 	// equivalent to std::for_each() using this range as input.
-	template<typename UnaryFunction> constexpr decltype(auto) for_each(UnaryFunction &&f) const& { return std::for_each(_begin, _end, std::forward<UnaryFunction>(f)); }
-	template<typename UnaryFunction> constexpr decltype(auto) for_each(UnaryFunction &&f) && { return std::for_each(std::move(_begin), std::move(_end), std::forward<UnaryFunction>(f)); }
+	template<typename UnaryFunction> constexpr decltype(auto) for_each(UnaryFunction &&f) const& { return __for_each(_begin, _end, std::forward<UnaryFunction>(f)); }
+	template<typename UnaryFunction> constexpr decltype(auto) for_each(UnaryFunction &&f) && { return __for_each(std::move(_begin), std::move(_end), std::forward<UnaryFunction>(f)); }
 
 	// equivalent to std::for_each() using this range as input.
 	template<typename Policy, typename UnaryFunction>
-	void for_each(Policy &&policy, UnaryFunction &&f) const& { return std::for_each(std::forward<Policy>(policy), _begin, _end, std::forward<UnaryFunction>(f)); }
+	void for_each(Policy &&policy, UnaryFunction &&f) const& { return __par_for_each(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), std::forward<UnaryFunction>(f)); }
 	template<typename Policy, typename UnaryFunction>
-	void for_each(Policy &&policy, UnaryFunction &&f) && { return std::for_each(std::forward<Policy>(policy), std::move(_begin), std::move(_end), std::forward<UnaryFunction>(f)); }
+	void for_each(Policy &&policy, UnaryFunction &&f) && { auto e = __common_end(_begin, std::move(_end)); return __par_for_each(std::forward<Policy>(policy), std::move(_begin), std::move(e), std::forward<UnaryFunction>(f)); }
 
 	// equivalent to std::count() using this range as input.
-	template<typename T> constexpr decltype(auto) count(const T &value) const& { return std::count(_begin, _end, value); }
-	template<typename T> constexpr decltype(auto) count(const T &value) && { return std::count(std::move(_begin), std::move(_end), value); }
+	template<typename T> constexpr decltype(auto) count(const T &value) const& { return __count(_begin, _end, value); }
+	template<typename T> constexpr decltype(auto) count(const T &value) && { return __count(std::move(_begin), std::move(_end), value); }
 
 	// equivalent to std::count_if() using this range as input.
-	template<typename UnaryPredicate> constexpr decltype(auto) count_if(UnaryPredicate &&p) const& { return std::count_if(_begin, _end, std::forward<UnaryPredicate>(p)); }
-	template<typename UnaryPredicate> constexpr decltype(auto) count_if(UnaryPredicate &&p) && { return std::count_if(std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
+	template<typename UnaryPredicate> constexpr decltype(auto) count_if(UnaryPredicate &&p) const& { return __count_if(_begin, _end, std::forward<UnaryPredicate>(p)); }
+	template<typename UnaryPredicate> constexpr decltype(auto) count_if(UnaryPredicate &&p) && { return __count_if(std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
 
 	// equivalent to std::count() using this range as input.
 	template<typename Policy, typename T>
-	constexpr decltype(auto) count(Policy &&policy, const T &value) const& { return std::count(std::forward<Policy>(policy), _begin, _end, value); }
+	constexpr decltype(auto) count(Policy &&policy, const T &value) const& { return __par_count(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), value); }
 	template<typename Policy, typename T>
-	constexpr decltype(auto) count(Policy &&policy, const T &value) && { return std::count(std::forward<Policy>(policy), std::move(_begin), std::move(_end), value); }
+	constexpr decltype(auto) count(Policy &&policy, const T &value) && { auto e = __common_end(_begin, std::move(_end)); return __par_count(std::forward<Policy>(policy), std::move(_begin), std::move(e), value); }
 
 	// equivalent to std::count_if() using this range as input.
 	template<typename Policy, typename UnaryPredicate>
-	constexpr decltype(auto) count_if(Policy &&policy, UnaryPredicate &&p) const& { return std::count_if(std::forward<Policy>(policy), _begin, _end, std::forward<UnaryPredicate>(p)); }
+	constexpr decltype(auto) count_if(Policy &&policy, UnaryPredicate &&p) const& { return __par_count_if(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), std::forward<UnaryPredicate>(p)); }
 	template<typename Policy, typename UnaryPredicate>
-	constexpr decltype(auto) count_if(Policy &&policy, UnaryPredicate &&p) && { return std::count_if(std::forward<Policy>(policy), std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
+	constexpr decltype(auto) count_if(Policy &&policy, UnaryPredicate &&p) && { auto e = __common_end(_begin, std::move(_end)); return __par_count_if(std::forward<Policy>(policy), std::move(_begin), std::move(e), std::forward<UnaryPredicate>(p)); }
 
 	// equivalent to std::find() using this range as input.
-	template<typename T> constexpr decltype(auto) find(const T &value) const& { return std::find(_begin, _end, value); }
-	template<typename T> constexpr decltype(auto) find(const T &value) && { return std::find(std::move(_begin), std::move(_end), value); }
+	template<typename T> constexpr decltype(auto) find(const T &value) const& { return __find(_begin, _end, value); }
+	template<typename T> constexpr decltype(auto) find(const T &value) && { return __find(std::move(_begin), std::move(_end), value); }
 
 	// equivalent to std::find_if() using this range as input.
-	template<typename UnaryPredicate> constexpr decltype(auto) find_if(UnaryPredicate &&p) const& { return std::find_if(_begin, _end, std::forward<UnaryPredicate>(p)); }
-	template<typename UnaryPredicate> constexpr decltype(auto) find_if(UnaryPredicate &&p) && { return std::find_if(std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
+	template<typename UnaryPredicate> constexpr decltype(auto) find_if(UnaryPredicate &&p) const& { return __find_if(_begin, _end, std::forward<UnaryPredicate>(p)); }
+	template<typename UnaryPredicate> constexpr decltype(auto) find_if(UnaryPredicate &&p) && { return __find_if(std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
 
 	// equivalent to std::find_if_not() using this range as input.
-	template<typename UnaryPredicate> constexpr decltype(auto) find_if_not(UnaryPredicate &&p) const& { return std::find_if_not(_begin, _end, std::forward<UnaryPredicate>(p)); }
-	template<typename UnaryPredicate> constexpr decltype(auto) find_if_not(UnaryPredicate &&p) && { return std::find_if_not(std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
+	template<typename UnaryPredicate> constexpr decltype(auto) find_if_not(UnaryPredicate &&p) const& { return __find_if_not(_begin, _end, std::forward<UnaryPredicate>(p)); }
+	template<typename UnaryPredicate> constexpr decltype(auto) find_if_not(UnaryPredicate &&p) && { return __find_if_not(std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
 
 	// equivalent to std::find() using this range as input.
 	template<typename Policy, typename T>
-	constexpr decltype(auto) find(Policy &&policy, const T &value) const& { return std::find(std::forward<Policy>(policy), _begin, _end, value); }
+	constexpr decltype(auto) find(Policy &&policy, const T &value) const& { return __par_find(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), value); }
 	template<typename Policy, typename T>
-	constexpr decltype(auto) find(Policy &&policy, const T &value) && { return std::find(std::forward<Policy>(policy), std::move(_begin), std::move(_end), value); }
+	constexpr decltype(auto) find(Policy &&policy, const T &value) && { auto e = __common_end(_begin, std::move(_end)); return __par_find(std::forward<Policy>(policy), std::move(_begin), std::move(e), value); }
 
 	// equivalent to std::find_if() using this range as input.
 	template<typename Policy, typename UnaryPredicate>
-	constexpr decltype(auto) find_if(Policy &&policy, UnaryPredicate &&p) const& { return std::find_if(std::forward<Policy>(policy), _begin, _end, std::forward<UnaryPredicate>(p)); }
+	constexpr decltype(auto) find_if(Policy &&policy, UnaryPredicate &&p) const& { return __par_find_if(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), std::forward<UnaryPredicate>(p)); }
 	template<typename Policy, typename UnaryPredicate>
-	constexpr decltype(auto) find_if(Policy &&policy, UnaryPredicate &&p) && { return std::find_if(std::forward<Policy>(policy), std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
+	constexpr decltype(auto) find_if(Policy &&policy, UnaryPredicate &&p) && { auto e = __common_end(_begin, std::move(_end)); return __par_find_if(std::forward<Policy>(policy), std::move(_begin), std::move(e), std::forward<UnaryPredicate>(p)); }
 
 	// equivalent to std::find_if_not() using this range as input.
 	template<typename Policy, typename UnaryPredicate>
-	constexpr decltype(auto) find_if_not(Policy &&policy, UnaryPredicate &&p) const& { return std::find_if_not(std::forward<Policy>(policy), _begin, _end, std::forward<UnaryPredicate>(p)); }
+	constexpr decltype(auto) find_if_not(Policy &&policy, UnaryPredicate &&p) const& { return __par_find_if_not(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), std::forward<UnaryPredicate>(p)); }
 	template<typename Policy, typename UnaryPredicate>
-	constexpr decltype(auto) find_if_not(Policy &&policy, UnaryPredicate &&p) && { return std::find_if_not(std::forward<Policy>(policy), std::move(_begin), std::move(_end), std::forward<UnaryPredicate>(p)); }
+	constexpr decltype(auto) find_if_not(Policy &&policy, UnaryPredicate &&p) && { auto e = __common_end(_begin, std::move(_end)); return __par_find_if_not(std::forward<Policy>(policy), std::move(_begin), std::move(e), std::forward<UnaryPredicate>(p)); }
 
 	// equivalent to std::adjacent_find() using this range as input.
-	constexpr decltype(auto) adjacent_find() const& { return std::adjacent_find(_begin, _end); }
-	constexpr decltype(auto) adjacent_find() && { return std::adjacent_find(std::move(_begin), std::move(_end)); }
+	constexpr decltype(auto) adjacent_find() const& { return __adjacent_find(_begin, _end); }
+	constexpr decltype(auto) adjacent_find() && { return __adjacent_find(std::move(_begin), std::move(_end)); }
 
 	// equivalent to std::adjacent_find() using this range as input.
-	template<typename BinaryPredicate> constexpr decltype(auto) adjacent_find(BinaryPredicate &&p) const& { return std::adjacent_find(_begin, _end, std::forward<BinaryPredicate>(p)); }
-	template<typename BinaryPredicate> constexpr decltype(auto) adjacent_find(BinaryPredicate &&p) && { return std::adjacent_find(std::move(_begin), std::move(_end), std::forward<BinaryPredicate>(p)); }
+	template<typename BinaryPredicate> constexpr decltype(auto) adjacent_find(BinaryPredicate &&p) const& { return __adjacent_find(_begin, _end, std::forward<BinaryPredicate>(p)); }
+	template<typename BinaryPredicate> constexpr decltype(auto) adjacent_find(BinaryPredicate &&p) && { return __adjacent_find(std::move(_begin), std::move(_end), std::forward<BinaryPredicate>(p)); }
 
 	// equivalent to std::search_n() using this range as input.
-	template<typename Size, typename T> constexpr decltype(auto) search_n(Size count, const T &value) const& { return std::search_n(_begin, _end, count, value); }
-	template<typename Size, typename T> constexpr decltype(auto) search_n(Size count, const T &value) && { return std::search_n(std::move(_begin), std::move(_end), count, value); }
+	template<typename Size, typename T> constexpr decltype(auto) search_n(Size count, const T &value) const& { return __search_n(_begin, _end, count, value); }
+	template<typename Size, typename T> constexpr decltype(auto) search_n(Size count, const T &value) && { return __search_n(std::move(_begin), std::move(_end), count, value); }
 
 	// equivalent to std::search_n() using this range as input.
 	template<typename Size, typename T, typename BinaryPredicate>
-	constexpr decltype(auto) search_n(Size count, const T &value, BinaryPredicate &&p) const& { return std::search_n(_begin, _end, count, value, std::forward<BinaryPredicate>(p)); }
+	constexpr decltype(auto) search_n(Size count, const T &value, BinaryPredicate &&p) const& { return __search_n(_begin, _end, count, value, std::forward<BinaryPredicate>(p)); }
 	template<typename Size, typename T, typename BinaryPredicate>
-	constexpr decltype(auto) search_n(Size count, const T &value, BinaryPredicate &&p) && { return std::search_n(std::move(_begin), std::move(_end), count, value, std::forward<BinaryPredicate>(p)); }
+	constexpr decltype(auto) search_n(Size count, const T &value, BinaryPredicate &&p) && { return __search_n(std::move(_begin), std::move(_end), count, value, std::forward<BinaryPredicate>(p)); }
 
 	// equivalent to std::search_n() using this range as input.
 	template<typename Policy, typename Size, typename T>
-	constexpr decltype(auto) search_n(Policy &&policy, Size count, const T &value) const& { return std::search_n(std::forward<Policy>(policy), _begin, _end, count, value); }
+	constexpr decltype(auto) search_n(Policy &&policy, Size count, const T &value) const& { return __par_search_n(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), count, value); }
 	template<typename Policy, typename Size, typename T>
-	constexpr decltype(auto) search_n(Policy &&policy, Size count, const T &value) && { return std::search_n(std::forward<Policy>(policy), std::move(_begin), std::move(_end), count, value); }
+	constexpr decltype(auto) search_n(Policy &&policy, Size count, const T &value) && { auto e = __common_end(_begin, std::move(_end)); return __par_search_n(std::forward<Policy>(policy), std::move(_begin), std::move(e), count, value); }
 
 	// equivalent to std::search_n() using this range as input.
 	template<typename Policy, typename Size, typename T, typename BinaryPredicate>
-	constexpr decltype(auto) search_n(Policy &&policy, Size count, const T &value, BinaryPredicate &&p) const& { return std::search_n(std::forward<Policy>(policy), _begin, _end, count, value, std::forward<BinaryPredicate>(p)); }
+	constexpr decltype(auto) search_n(Policy &&policy, Size count, const T &value, BinaryPredicate &&p) const& { return __par_search_n(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), count, value, std::forward<BinaryPredicate>(p)); }
 	template<typename Policy, typename Size, typename T, typename BinaryPredicate>
-	constexpr decltype(auto) search_n(Policy &&policy, Size count, const T &value, BinaryPredicate &&p) && { return std::search_n(std::forward<Policy>(policy), std::move(_begin), std::move(_end), count, value, std::forward<BinaryPredicate>(p)); }
+	constexpr decltype(auto) search_n(Policy &&policy, Size count, const T &value, BinaryPredicate &&p) && { auto e = __common_end(_begin, std::move(_end)); return __par_search_n(std::forward<Policy>(policy), std::move(_begin), std::move(e), count, value, std::forward<BinaryPredicate>(p)); }
 
 public: // -- stdlib modification wrappers -- //
 
 	// equivalent to std::copy() from this range to some other destination.
-	template<typename OutputIt> constexpr decltype(auto) copy(OutputIt dest) const& { std::copy(_begin, _end, dest); }
-	template<typename OutputIt> constexpr decltype(auto) copy(OutputIt dest) && { std::copy(std::move(_begin), std::move(_end), dest); }
+	template<typename OutputIt> constexpr decltype(auto) copy(OutputIt dest) const& { __copy(_begin, _end, dest); }
+	template<typename OutputIt> constexpr decltype(auto) copy(OutputIt dest) && { __copy(std::move(_begin), std::move(_end), dest); }
 
 	// equivalent to std::copy_if() from this range to some other destination.
 	template<typename OutputIt, typename UnaryPredicate>
-	constexpr decltype(auto) copy_if(OutputIt dest, UnaryPredicate &&p) const& { std::copy_if(_begin, _end, dest, std::forward<UnaryPredicate>(p)); }
+	constexpr decltype(auto) copy_if(OutputIt dest, UnaryPredicate &&p) const& { __copy_if(_begin, _end, dest, std::forward<UnaryPredicate>(p)); }
 	template<typename OutputIt, typename UnaryPredicate>
-	constexpr decltype(auto) copy_if(OutputIt dest, UnaryPredicate &&p) && { std::copy_if(std::move(_begin), std::move(_end), dest, std::forward<UnaryPredicate>(p)); }
+	constexpr decltype(auto) copy_if(OutputIt dest, UnaryPredicate &&p) && { __copy_if(std::move(_begin), std::move(_end), dest, std::forward<UnaryPredicate>(p)); }
 
 	// equivalent to std::copy() from this range to some other destination.
 	template<typename Policy, typename OutputIt>
-	constexpr decltype(auto) copy(Policy &&policy, OutputIt dest) const& { std::copy(std::forward<Policy>(policy), _begin, _end, dest); }
+	constexpr decltype(auto) copy(Policy &&policy, OutputIt dest) const& { __par_copy(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), dest); }
 	template<typename Policy, typename OutputIt>
-	constexpr decltype(auto) copy(Policy &&policy, OutputIt dest) && { std::copy(std::forward<Policy>(policy), std::move(_begin), std::move(_end), dest); }
+	constexpr decltype(auto) copy(Policy &&policy, OutputIt dest) && { auto e = __common_end(_begin, std::move(_end)); __par_copy(std::forward<Policy>(policy), std::move(_begin), std::move(e), dest); }
 
 	// equivalent to std::copy_if() from this range to some other destination.
 	template<typename Policy, typename OutputIt, typename UnaryPredicate>
-	constexpr decltype(auto) copy_if(Policy &&policy, OutputIt dest, UnaryPredicate &&p) const& { std::copy_if(std::forward<Policy>(policy), _begin, _end, dest, std::forward<UnaryPredicate>(p)); }
+	constexpr decltype(auto) copy_if(Policy &&policy, OutputIt dest, UnaryPredicate &&p) const& { __par_copy_if(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), dest, std::forward<UnaryPredicate>(p)); }
 	template<typename Policy, typename OutputIt, typename UnaryPredicate>
-	constexpr decltype(auto) copy_if(Policy &&policy, OutputIt dest, UnaryPredicate &&p) && { std::copy_if(std::forward<Policy>(policy), std::move(_begin), std::move(_end), dest, std::forward<UnaryPredicate>(p)); }
+	constexpr decltype(auto) copy_if(Policy &&policy, OutputIt dest, UnaryPredicate &&p) && { auto e = __common_end(_begin, std::move(_end)); __par_copy_if(std::forward<Policy>(policy), std::move(_begin), std::move(e), dest, std::forward<UnaryPredicate>(p)); }
 
 	// equivalent to std::copy_backward() from this range to some other destination.
-	template<typename BidirIt> constexpr decltype(auto) copy_backward(BidirIt dest_end) const& { return std::copy_backward(_begin, _end, dest_end); }
-	template<typename BidirIt> constexpr decltype(auto) copy_backward(BidirIt dest_end) && { return std::copy_backward(_begin, _end, dest_end); }
+	template<typename BidirIt> constexpr decltype(auto) copy_backward(BidirIt dest_end) const& { return std::copy_backward(_begin, __common_end(_begin, _end), dest_end); }
+	template<typename BidirIt> constexpr decltype(auto) copy_backward(BidirIt dest_end) && { return std::copy_backward(_begin, __common_end(_begin, _end), dest_end); }
 
 	// equivalent to std::move() from this range to some other destination.
-	template<typename OutputIt> constexpr decltype(auto) move(OutputIt dest) const& { return std::move(_begin, _end, dest); }
-	template<typename OutputIt> constexpr decltype(auto) move(OutputIt dest) && { return std::move(std::move(_begin), std::move(_end), dest); }
+	template<typename OutputIt> constexpr decltype(auto) move(OutputIt dest) const& { return __move(_begin, _end, dest); }
+	template<typename OutputIt> constexpr decltype(auto) move(OutputIt dest) && { return __move(std::move(_begin), std::move(_end), dest); }
 
 	// equivalent to std::move() from this range to some other destination.
 	template<typename Policy, typename OutputIt>
-	constexpr decltype(auto) move(Policy &&policy, OutputIt dest) const& { return std::move(std::forward<Policy>(policy), _begin, _end, dest); }
+	constexpr decltype(auto) move(Policy &&policy, OutputIt dest) const& { return __par_move(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), dest); }
 	template<typename Policy, typename OutputIt>
-	constexpr decltype(auto) move(Policy &&policy, OutputIt dest) && { return std::move(std::forward<Policy>(policy), std::move(_begin), std::move(_end), dest); }
+	constexpr decltype(auto) move(Policy &&policy, OutputIt dest) && { auto e = __common_end(_begin, std::move(_end)); return __par_move(std::forward<Policy>(policy), std::move(_begin), std::move(e), dest); }
 
 	// equivalent to std::move_backward() from this range to some other destination.
-	template<typename OutputIt> constexpr decltype(auto) move_backward(OutputIt dest_end) const& { return std::move_backward(_begin, _end, dest_end); }
-	template<typename OutputIt> constexpr decltype(auto) move_backward(OutputIt dest_end) && { return std::move_backward(std::move(_begin), std::move(_end), dest_end); }
+	template<typename OutputIt> constexpr decltype(auto) move_backward(OutputIt dest_end) const& { return std::move_backward(_begin, __common_end(_begin, _end), dest_end); }
+	template<typename OutputIt> constexpr decltype(auto) move_backward(OutputIt dest_end) && { auto e = __common_end(_begin, std::move(_end)); return std::move_backward(std::move(_begin), std::move(e), dest_end); }
 
 	// equivalent to std::fill() into this iterator range.
-	template<typename T> constexpr void fill(const T &value) { std::fill(_begin, _end, value); }
+	template<typename T> constexpr void fill(const T &value) { __fill(_begin, _end, value); }
 
 	// equivalent to std::fill() into this iterator range.
-	template<typename Policy, typename T> void fill(Policy &&policy, const T &value) { std::fill(std::forward<Policy>(policy), _begin, _end, value); }
+	template<typename Policy, typename T> void fill(Policy &&policy, const T &value) { __par_fill(std::forward<Policy>(policy), _begin, __common_end(_begin, _end), value); }
 
 	// transform
 };
@@ -889,7 +3796,645 @@ template<typename T>
 iterator_range<value_iterator<T>, value_iterator<T>> make_value_range(const T &begin, const T &end) { return { value_iterator<T>(begin), value_iterator<T>(end) }; }
 
 // given a begin iterator and a count, creates the iterator range [begin, begin + count) using counting iterators
+// the end is a count_sentinel, so the range only holds one copy of begin.
 template<typename Iter>
-iterator_range<count_iterator<Iter>, count_iterator<Iter>> make_count_range(const Iter &begin, std::size_t count) { return { count_iterator<Iter>(begin, 0), count_iterator<Iter>(begin, count) }; }
+iterator_range<count_iterator<Iter>, count_sentinel> make_count_range(const Iter &begin, std::size_t count) { return { count_iterator<Iter>(begin, 0), count_sentinel((count_sentinel::count_t)count) }; }
+
+// walks the lines of a character buffer - dereferencing gives a std::string_view of the current line (without its line ending) into the buffer.
+// lines end with "\n" or "\r\n", and the last line doesn't need a line ending (an empty buffer has no lines, and "a\n" has one).
+// line endings are found with std::memchr, which the stdlib implements as a vectorized scan, rather than a loop over each character.
+// the buffer is never copied, so it must outlive the iterator and the views it gives.
+class line_iterator
+{
+public: // -- traits -- //
+
+	typedef std::forward_iterator_tag iterator_category;
+	typedef std::ptrdiff_t difference_type;
+
+	typedef std::string_view value_type;
+
+	typedef arrow_proxy<std::string_view> pointer;
+	typedef std::string_view reference;
+
+private: // -- data -- //
+
+	const char *pos;  // the start of the current line (stop at the end)
+	const char *eol;  // the end of the current line - the position of its '\n' (or stop if it has none)
+	const char *stop; // the end of the buffer
+
+private: // -- helpers -- //
+
+	// returns the position of the first '\n' in [p, stop), or stop if there is none.
+	const char *__find_eol(const char *p) const noexcept
+	{
+		const void *nl = p == stop ? nullptr : std::memchr(p, '\n', (std::size_t)(stop - p));
+		return nl ? static_cast<const char*>(nl) : stop;
+	}
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates a new line iterator at the start of a line at first in the buffer ending at last - line_iterator(last, last) is the end.
+	line_iterator(const char *first, const char *last) noexcept : pos(first), eol(nullptr), stop(last) { eol = __find_eol(pos); }
+
+public: // -- access -- //
+
+	// returns a view of the current line (without its line ending)
+	std::string_view operator*() const noexcept
+	{
+		std::size_t len = (std::size_t)(eol - pos);
+		if (len > 0 && pos[len - 1] == '\r') --len;
+		return { pos, len };
+	}
+
+	// returns an arrow proxy holding a view of the current line (see arrow_proxy).
+	pointer operator->() const noexcept { return pointer(**this); }
+
+public: // -- raw access -- //
+
+	// gets the start of the current line.
+	const char *get_iter() const noexcept { return pos; }
+
+	// gets the end of the buffer.
+	const char *get_end() const noexcept { return stop; }
+
+public: // -- forward iterator functions -- //
+
+	// moves to the next line
+	line_iterator &operator++() noexcept { pos = eol == stop ? stop : eol + 1; eol = __find_eol(pos); return *this; }
+	line_iterator operator++(int) noexcept { line_iterator cpy(*this); ++*this; return cpy; }
+
+public: // -- comparison -- //
+
+	// compares the starts of the current lines
+	friend bool operator==(const line_iterator &a, const line_iterator &b) noexcept { return a.pos == b.pos; }
+	friend bool operator!=(const line_iterator &a, const line_iterator &b) noexcept { return a.pos != b.pos; }
+};
+
+// returns the range of lines in the buffer [first, last) (see line_iterator).
+inline iterator_range<line_iterator> make_line_range(const char *first, const char *last) { return { line_iterator(first, last), line_iterator(last, last) }; }
+// returns the range of lines in the buffer (see line_iterator) - e.g. a std::string, or a string literal.
+inline iterator_range<line_iterator> make_line_range(std::string_view buffer) { return make_line_range(buffer.data(), buffer.data() + buffer.size()); }
+// returns the range of lines in the buffer (see line_iterator) - e.g. a memory-mapped file (see mmap_range).
+inline iterator_range<line_iterator> make_line_range(const iterator_range<const char*, const char*> &buffer) { return make_line_range(buffer.begin(), buffer.end()); }
+
+// walks the fields of a delimited record (e.g. a line of a csv or tsv file) - dereferencing gives a std::string_view of the current field into the record.
+// a field that starts with the quote character runs to the matching closing quote, so it may contain delimiters - two quotes in a row inside it are an
+// escaped quote. the view of a quoted field excludes the surrounding quotes but is otherwise the raw text (escaped quotes stay doubled), so nothing is copied.
+// anything between a closing quote and the next delimiter is ignored, and an unterminated quoted field runs to the end of the record.
+// a record with n delimiters (outside of quotes) has n + 1 fields - e.g. "" has one empty field and "a," has two.
+// delimiters and quotes are found with std::memchr (a vectorized scan) - see line_iterator, which this can be nested under (see field_splitter).
+// the record is never copied, so it must outlive the iterator and the views it gives.
+class field_iterator
+{
+public: // -- traits -- //
+
+	typedef std::forward_iterator_tag iterator_category;
+	typedef std::ptrdiff_t difference_type;
+
+	typedef std::string_view value_type;
+
+	typedef arrow_proxy<std::string_view> pointer;
+	typedef std::string_view reference;
+
+private: // -- data -- //
+
+	const char *pos;  // the start of the current field (null at the end)
+	const char *next; // the start of the next field (null if this is the last one)
+	const char *stop; // the end of the record
+
+	const char *first; // the start of the current field's value
+	const char *last;  // the end of the current field's value
+
+	char delim; // the delimiter
+	char quote; // the quote character
+
+private: // -- helpers -- //
+
+	// returns the position of the first c in [p, stop), or null if there is none.
+	const char *__find(const char *p, char c) const noexcept { return p == stop ? nullptr : static_cast<const char*>(std::memchr(p, c, (std::size_t)(stop - p))); }
+
+	// finds the value of the field starting at pos and the start of the next field.
+	void __parse() noexcept
+	{
+		if (pos == nullptr) return;
+
+		const char *after = pos; // where to look for the delimiter that ends the field
+		if (pos != stop && *pos == quote)
+		{
+			first = pos + 1;
+			for (const char *p = first; ; p += 2)
+			{
+				p = __find(p, quote);
+				if (!p) { last = after = stop; break; }
+				if (p + 1 == stop || p[1] != quote) { last = p; after = p + 1; break; }
+			}
+		}
+		else first = pos;
+
+		const char *d = __find(after, delim);
+		if (first == pos) last = d ? d : stop;
+		next = d ? d + 1 : nullptr;
+	}
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates an end field iterator.
+	field_iterator() noexcept : pos(nullptr), next(nullptr), stop(nullptr), first(nullptr), last(nullptr), delim(','), quote('"') {}
+
+	// creates a new field iterator at the first field of the record [_first, _last).
+	field_iterator(const char *_first, const char *_last, char _delim = ',', char _quote = '"') noexcept
+		: pos(_first), next(nullptr), stop(_last), first(nullptr), last(nullptr), delim(_delim), quote(_quote)
+	{
+		__parse();
+	}
+
+public: // -- access -- //
+
+	// returns a view of the current field's value
+	std::string_view operator*() const noexcept { return { first, (std::size_t)(last - first) }; }
+
+	// returns an arrow proxy holding a view of the current field's value (see arrow_proxy).
+	pointer operator->() const noexcept { return pointer(**this); }
+
+public: // -- raw access -- //
+
+	// gets the start of the current field (including its opening quote, if any) - this is null at the end.
+	const char *get_iter() const noexcept { return pos; }
+
+	// gets the end of the record.
+	const char *get_end() const noexcept { return stop; }
+
+public: // -- forward iterator functions -- //
+
+	// moves to the next field
+	field_iterator &operator++() noexcept { pos = next; __parse(); return *this; }
+	field_iterator operator++(int) noexcept { field_iterator cpy(*this); ++*this; return cpy; }
+
+public: // -- comparison -- //
+
+	// compares the starts of the current fields
+	friend bool operator==(const field_iterator &a, const field_iterator &b) noexcept { return a.pos == b.pos; }
+	friend bool operator!=(const field_iterator &a, const field_iterator &b) noexcept { return a.pos != b.pos; }
+};
+
+// returns the range of fields in the given record (see field_iterator).
+inline iterator_range<field_iterator> make_field_range(std::string_view record, char delim = ',', char quote = '"')
+{
+	return { field_iterator(record.data(), record.data() + record.size(), delim, quote), field_iterator() };
+}
+
+// a function object that splits records into their fields (see field_iterator) - this is meant for mapping a range of lines to ranges of fields,
+// e.g. make_line_range(buffer).map(field_splitter{ '\t' }) is a lazy two-level parse of a tsv buffer that never allocates.
+struct field_splitter
+{
+	char delim = ','; // the delimiter
+	char quote = '"'; // the quote character
+
+	// returns the range of fields in the given record
+	iterator_range<field_iterator> operator()(std::string_view record) const { return make_field_range(record, delim, quote); }
+};
+
+// reads a binary stream of trivially copyable T records (e.g. a file written with fwrite()) - this is a bulk-reading replacement for std::istream_iterator<T>.
+// records are read into a buffer a large block at a time and handed out from there, instead of one formatted extraction per element.
+// the source is a std::istream or a posix file descriptor, which must outlive the iterator and isn't closed by it.
+// this is an input iterator: all copies share the source and buffer, so incrementing one copy advances all of them.
+// a default constructed iterator is the end, which an iterator compares equal to once the source runs out (a trailing partial record is ignored).
+// note that the source is read ahead a block at a time, so it is usually advanced past records the iterator hasn't reached yet -
+// e.g. stopping after n records with make_count_range() leaves the rest of the block consumed from the source and lost.
+// to read a known number of records and leave the source just past them (e.g. a header count, then the rest), pass max_records
+// (see make_binary_read_range_n) - the iterator then never reads more than that from the source, and reaches the end after that many records.
+template<typename T>
+class binary_read_iterator
+{
+	static_assert(std::is_trivially_copyable<T>::value, "binary_read_iterator can only read trivially copyable types");
+
+public: // -- traits -- //
+
+	typedef std::input_iterator_tag iterator_category;
+	typedef std::ptrdiff_t difference_type;
+
+	typedef T value_type;
+
+	typedef const T *pointer;
+	typedef const T &reference;
+
+public: // -- types -- //
+
+	// the default number of records to read at a time (64 KiB worth, or 1 for larger records)
+	static constexpr std::size_t default_block_size = sizeof(T) < 65536 ? 65536 / sizeof(T) : 1;
+	// the default max_records - no limit on the number of records read
+	static constexpr std::size_t unlimited = (std::size_t)-1;
+
+private: // -- types -- //
+
+	// storage for a single record
+	struct alignas(T) record_t { char bytes[sizeof(T)]; };
+
+	// the state shared by all copies of an iterator
+	struct state_t
+	{
+		std::istream *in; // the source stream (null if reading from fd)
+		int fd;           // the source file descriptor (only used if in is null)
+
+		std::unique_ptr<record_t[]> buf; // the buffer
+		std::size_t cap;                 // the capacity of the buffer in records
+
+		std::size_t bytes = 0; // the number of bytes in the buffer
+		std::size_t pos = 0;   // the index of the current record in the buffer
+		std::size_t left;      // the number of bytes that may still be read from the source (see max_records)
+		bool done = false;     // true once the source has run out of whole records
+
+		state_t(std::istream *_in, int _fd, std::size_t block_size, std::size_t max_records)
+			: in(_in), fd(_fd), buf(new record_t[block_size > 0 ? block_size : 1]), cap(block_size > 0 ? block_size : 1),
+			left(max_records > (std::size_t)-1 / sizeof(T) ? (std::size_t)-1 : max_records * sizeof(T))
+		{
+			fill();
+		}
+
+		// reads up to n bytes to p (but no more than are left) - returns the number of bytes read (0 at the end of the source).
+		// stream errors end the stream (as for std::istream_iterator) - file descriptor errors throw std::system_error.
+		std::size_t read(char *p, std::size_t n)
+		{
+			if (n > left) n = left;
+			if (n == 0) return 0;
+			if (in) { in->read(p, (std::streamsize)n); n = (std::size_t)in->gcount(); left -= n; return n; }
+#ifdef DRAGAZO_ITERATORS_PLUS_PLUS_POSIX
+			for (;;)
+			{
+				const ::ssize_t r = ::read(fd, p, n);
+				if (r >= 0) { left -= (std::size_t)r; return (std::size_t)r; }
+				if (errno != EINTR) throw std::system_error(errno, std::generic_category(), "failed to read from file descriptor");
+			}
+#else
+			return 0;
+#endif
+		}
+
+		// refills the buffer once every whole record in it has been used - any partial record at the end of the buffer is kept.
+		void fill()
+		{
+			char *const raw = reinterpret_cast<char*>(buf.get());
+			const std::size_t used = pos * sizeof(T);
+			std::memmove(raw, raw + used, bytes - used);
+			bytes -= used;
+			pos = 0;
+
+			while (bytes < sizeof(T))
+			{
+				const std::size_t n = read(raw + bytes, cap * sizeof(T) - bytes);
+				if (n == 0) { done = true; return; }
+				bytes += n;
+			}
+		}
+	};
+
+	// holds a value from before an increment (for *it++)
+	class postfix_value
+	{
+	private: // -- data -- //
+
+		T value; // the held value
+
+	public: // -- ctor / dtor / asgn -- //
+
+		explicit postfix_value(const T &v) : value(v) {}
+
+	public: // -- value access -- //
+
+		// returns the held value
+		const T &operator*() const noexcept { return value; }
+	};
+
+private: // -- data -- //
+
+	std::shared_ptr<state_t> state; // the shared state - null for the end iterator
+
+private: // -- helpers -- //
+
+	// returns true if this iterator is at the end of its source
+	bool __at_end() const noexcept { return !state || state->done; }
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates an end iterator.
+	binary_read_iterator() = default;
+
+	// creates a new binary read iterator over the given stream, which reads block_size records at a time and at most max_records in total.
+	// the first block is read immediately.
+	explicit binary_read_iterator(std::istream &in, std::size_t block_size = default_block_size, std::size_t max_records = unlimited)
+		: state(std::make_shared<state_t>(&in, -1, block_size, max_records))
+	{}
+
+#ifdef DRAGAZO_ITERATORS_PLUS_PLUS_POSIX
+	// creates a new binary read iterator over the given file descriptor, which reads block_size records at a time and at most max_records in total.
+	// the first block is read immediately - this throws std::system_error if a read fails.
+	explicit binary_read_iterator(int fd, std::size_t block_size = default_block_size, std::size_t max_records = unlimited)
+		: state(std::make_shared<state_t>(nullptr, fd, block_size, max_records))
+	{}
+#endif
+
+public: // -- value access -- //
+
+	// returns the current record - this is only valid until the next increment.
+	const T &operator*() const noexcept { return reinterpret_cast<const T&>(state->buf[state->pos]); }
+
+	// returns the address of the current record - this is only valid until the next increment.
+	const T *operator->() const noexcept { return std::addressof(**this); }
+
+public: // -- inc -- //
+
+	// moves to the next record, reading the next block once the buffer is used up (this is visible through every copy)
+	binary_read_iterator &operator++() { if (++state->pos == state->bytes / sizeof(T)) state->fill(); return *this; }
+	postfix_value operator++(int) { postfix_value cpy(**this); ++*this; return cpy; }
+
+public: // -- comparison -- //
+
+	// two iterators are equal if they're both at the end, or if they share the same source
+	friend bool operator==(const binary_read_iterator &a, const binary_read_iterator &b) noexcept { return a.__at_end() ? b.__at_end() : !b.__at_end() && a.state == b.state; }
+	friend bool operator!=(const binary_read_iterator &a, const binary_read_iterator &b) noexcept { return !(a == b); }
+};
+
+// returns the range of T records in the given stream (see binary_read_iterator).
+template<typename T>
+iterator_range<binary_read_iterator<T>> make_binary_read_range(std::istream &in, std::size_t block_size = binary_read_iterator<T>::default_block_size) { return { binary_read_iterator<T>(in, block_size), binary_read_iterator<T>() }; }
+
+#ifdef DRAGAZO_ITERATORS_PLUS_PLUS_POSIX
+// returns the range of T records in the given file descriptor (see binary_read_iterator).
+template<typename T>
+iterator_range<binary_read_iterator<T>> make_binary_read_range(int fd, std::size_t block_size = binary_read_iterator<T>::default_block_size) { return { binary_read_iterator<T>(fd, block_size), binary_read_iterator<T>() }; }
+#endif
+
+// returns the range of the next count T records in the given stream (fewer if it runs out first) - unlike make_count_range(),
+// this never reads past them, so the stream is left just after the last record (see binary_read_iterator).
+template<typename T>
+iterator_range<binary_read_iterator<T>> make_binary_read_range_n(std::istream &in, std::size_t count, std::size_t block_size = binary_read_iterator<T>::default_block_size) { return { binary_read_iterator<T>(in, block_size, count), binary_read_iterator<T>() }; }
+
+#ifdef DRAGAZO_ITERATORS_PLUS_PLUS_POSIX
+// returns the range of the next count T records in the given file descriptor (fewer if it runs out first) - unlike make_count_range(),
+// this never reads past them, so the file descriptor is left just after the last record (see binary_read_iterator).
+template<typename T>
+iterator_range<binary_read_iterator<T>> make_binary_read_range_n(int fd, std::size_t count, std::size_t block_size = binary_read_iterator<T>::default_block_size) { return { binary_read_iterator<T>(fd, block_size, count), binary_read_iterator<T>() }; }
+#endif
+
+// writes values as text - this is a buffered replacement for std::ostream_iterator for dumping ranges (e.g. range.copy(text_output_iterator(std::cout, " "))).
+// arithmetic values are formatted with std::to_chars (so no locale is involved) into a large buffer, which is written to the destination in bulk.
+// as with std::ostream_iterator, the delimiter is written after every value. char, signed char, and unsigned char (e.g. std::uint8_t)
+// values and strings are written as text - wide character types (wchar_t, char16_t, etc.) aren't accepted, since there's no narrow text for them.
+// floating point values are written in their shortest round-trip form (std::to_chars without a format), not with the stream's precision.
+// the destination is a std::ostream or a posix file descriptor, which must outlive the iterator and isn't closed by it.
+// all copies share the buffer, which is flushed when it fills up, when flush() is called, and when the last copy is destroyed.
+// errors while flushing on destruction are ignored - call flush() first to have them reported (as std::system_error for file descriptors).
+class text_output_iterator
+{
+public: // -- traits -- //
+
+	typedef std::output_iterator_tag iterator_category;
+	typedef std::ptrdiff_t difference_type;
+
+	typedef void value_type;
+
+	typedef void pointer;
+	typedef void reference;
+
+public: // -- types -- //
+
+	// the default buffer size in bytes
+	static constexpr std::size_t default_buffer_size = 65536;
+
+private: // -- types -- //
+
+	// the most characters std::to_chars can produce for any arithmetic value (long double in its shortest form, with some room to spare)
+	static constexpr std::size_t max_value_chars = 128;
+
+	// the state shared by all copies of an iterator
+	struct state_t
+	{
+		std::ostream *out; // the destination stream (null if writing to fd)
+		int fd;            // the destination file descriptor (only used if out is null)
+
+		std::string delim; // the delimiter written after each value
+
+		std::unique_ptr<char[]> buf; // the buffer
+		std::size_t cap;             // the capacity of the buffer
+		std::size_t len = 0;         // the number of characters in the buffer
+
+		state_t(std::ostream *_out, int _fd, std::string_view _delim, std::size_t buffer_size)
+			: out(_out), fd(_fd), delim(_delim), cap(std::max(buffer_size, max_value_chars)) { buf.reset(new char[cap]); }
+		~state_t() { try { flush(); } catch (...) {} }
+
+		state_t(const state_t&) = delete;
+		state_t &operator=(const state_t&) = delete;
+
+		// writes n characters at p directly to the destination
+		void write(const char *p, std::size_t n)
+		{
+			if (out) { out->write(p, (std::streamsize)n); return; }
+#ifdef DRAGAZO_ITERATORS_PLUS_PLUS_POSIX
+			while (n > 0)
+			{
+				const ::ssize_t r = ::write(fd, p, n);
+				if (r >= 0) { p += r; n -= (std::size_t)r; }
+				else if (errno != EINTR) throw std::system_error(errno, std::generic_category(), "failed to write to file descriptor");
+			}
+#endif
+		}
+
+		// writes the buffer to the destination and empties it
+		void flush()
+		{
+			const std::size_t n = len;
+			len = 0;
+			if (n > 0) write(buf.get(), n);
+			if (out) out->flush();
+		}
+
+		// appends n characters at p to the buffer (or writes them directly if they don't fit in an empty buffer)
+		void append(const char *p, std::size_t n)
+		{
+			if (n > cap - len) flush();
+			if (n > cap) write(p, n);
+			else { std::memcpy(buf.get() + len, p, n); len += n; }
+		}
+
+		// appends the text form of value to the buffer
+		template<typename T>
+		void append_value(const T &value)
+		{
+			if (cap - len < max_value_chars) flush();
+			char *const p = buf.get() + len;
+			len = (std::size_t)(std::to_chars(p, buf.get() + cap, value).ptr - buf.get());
+		}
+	};
+
+private: // -- data -- //
+
+	std::shared_ptr<state_t> state; // the shared state
+
+private: // -- helpers -- //
+
+	// true if T is a wide character type, which std::to_chars doesn't format and which has no narrow text to write
+	template<typename T>
+	static constexpr bool __is_wide_char = std::is_same<T, wchar_t>::value || std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value
+#ifdef __cpp_char8_t
+		|| std::is_same<T, char8_t>::value
+#endif
+		;
+
+public: // -- ctor / dtor / asgn -- //
+
+	// creates a new text output iterator that writes to the given stream, with delim after each value.
+	explicit text_output_iterator(std::ostream &out, std::string_view delim = {}, std::size_t buffer_size = default_buffer_size) : state(std::make_shared<state_t>(&out, -1, delim, buffer_size)) {}
+
+#ifdef DRAGAZO_ITERATORS_PLUS_PLUS_POSIX
+	// creates a new text output iterator that writes to the given file descriptor, with delim after each value.
+	explicit text_output_iterator(int fd, std::string_view delim = {}, std::size_t buffer_size = default_buffer_size) : state(std::make_shared<state_t>(nullptr, fd, delim, buffer_size)) {}
+#endif
+
+public: // -- output -- //
+
+	// writes value as text, followed by the delimiter - bools are written as 0 or 1 and the narrow character types as characters (like std::ostream).
+	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value && !__is_wide_char<T>, int> = 0>
+	text_output_iterator &operator=(T value)
+	{
+		if constexpr (std::is_same<T, bool>::value) state->append_value((int)value);
+		else if constexpr (std::is_same<T, char>::value || std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value) state->append(reinterpret_cast<const char*>(&value), 1);
+		else state->append_value(value);
+		state->append(state->delim.data(), state->delim.size());
+		return *this;
+	}
+	// writes str, followed by the delimiter.
+	text_output_iterator &operator=(std::string_view str)
+	{
+		state->append(str.data(), str.size());
+		state->append(state->delim.data(), state->delim.size());
+		return *this;
+	}
+
+	// writes everything buffered so far to the destination (this is shared by every copy).
+	void flush() { state->flush(); }
+
+	// does nothing - writing is done by assignment (as for std::ostream_iterator)
+	text_output_iterator &operator*() noexcept { return *this; }
+	text_output_iterator &operator++() noexcept { return *this; }
+	text_output_iterator &operator++(int) noexcept { return *this; }
+};
+
+#ifdef DRAGAZO_ITERATORS_PLUS_PLUS_POSIX
+
+// hints for mapping a file with make_mmap_range() - these only affect performance, and any the platform doesn't support are ignored.
+struct mmap_options
+{
+	bool sequential = true; // the file will mostly be read front to back (MADV_SEQUENTIAL) - more aggressive readahead
+	bool willneed = true;   // start reading the file in right away (MADV_WILLNEED)
+	bool populate = false;  // fault the whole file in before returning (MAP_POPULATE) - this blocks until it's read, but avoids page faults later
+	bool hugepages = false; // back the mapping with huge pages where possible (MADV_HUGEPAGE) - fewer tlb misses over large files
+};
+
+// a file mapped read-only into memory and viewed as an array of T - this is an iterator range over const T* which also owns the mapping.
+// copies share the mapping, which is unmapped along with the last of them. ranges made from this one (e.g. by map()) only hold pointers,
+// so this range must outlive them - the adaptors are deleted for rvalue mmap ranges, so e.g. make_mmap_range<T>(path).map(f) doesn't compile
+// (keep the mmap range in a variable first). this range must likewise outlive any range it is zipped or concatenated onto.
+template<typename T>
+class mmap_range : public iterator_range<const T*, const T*>
+{
+	static_assert(std::is_trivially_copyable<T>::value, "mmap_range can only view trivially copyable types");
+
+	typedef iterator_range<const T*, const T*> base_t;
+
+private: // -- data -- //
+
+	std::shared_ptr<const void> mapping; // the mapping - null for files with no whole records
+
+private: // -- helpers -- //
+
+	// maps the file at path and returns the mapping and its size in bytes - this is null (with a size of 0) for files with no whole records.
+	static std::pair<std::shared_ptr<const void>, std::size_t> __map(const char *path, const mmap_options &options)
+	{
+		const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+		if (fd < 0) throw std::system_error(errno, std::generic_category(), std::string("failed to open ") + path);
+
+		struct stat info;
+		if (::fstat(fd, &info) != 0) { const int err = errno; ::close(fd); throw std::system_error(err, std::generic_category(), std::string("failed to stat ") + path); }
+		if ((std::size_t)info.st_size < sizeof(T)) { ::close(fd); return { nullptr, 0 }; }
+		const std::size_t len = (std::size_t)info.st_size;
+
+		int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+		if (options.populate) flags |= MAP_POPULATE;
+#endif
+		void *const p = ::mmap(nullptr, len, PROT_READ, flags, fd, 0);
+		const int err = errno;
+		::close(fd); // the mapping keeps its own reference to the file
+		if (p == MAP_FAILED) throw std::system_error(err, std::generic_category(), std::string("failed to map ") + path);
+
+		std::shared_ptr<const void> res(p, [len](const void *q) { ::munmap(const_cast<void*>(q), len); });
+
+		// these are only hints, so failures are ignored
+		if (options.sequential) ::madvise(p, len, MADV_SEQUENTIAL);
+		if (options.willneed) ::madvise(p, len, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+		if (options.hugepages) ::madvise(p, len, MADV_HUGEPAGE);
+#endif
+
+		return { std::move(res), len };
+	}
+
+	// creates a new mmap range over the first count elements of the given mapping.
+	mmap_range(std::shared_ptr<const void> _mapping, std::size_t count)
+		: iterator_range<const T*, const T*>(static_cast<const T*>(_mapping.get()), static_cast<const T*>(_mapping.get()) + count), mapping(std::move(_mapping))
+	{}
+
+	// creates a new mmap range over the whole records of the mapping of size bytes.
+	explicit mmap_range(std::pair<std::shared_ptr<const void>, std::size_t> map) : mmap_range(std::move(map.first), map.second / sizeof(T)) {}
+
+public: // -- ctor / dtor / asgn -- //
+
+	// maps the file at path read-only and creates a range over the whole T records in it (a trailing partial record is ignored).
+	// throws std::system_error if the file can't be opened, inspected, or mapped.
+	explicit mmap_range(const char *path, const mmap_options &options = {}) : mmap_range(__map(path, options)) {}
+
+public: // -- access -- //
+
+	// gets the mapping (shared by all copies of this range) - this is null for files with no whole records.
+	const std::shared_ptr<const void> &get_mapping() const noexcept { return mapping; }
+
+public: // -- adaptors -- //
+
+	// the adapted ranges don't own the mapping, so they can't be made from a temporary mmap range (which would unmap it at the end of the expression)
+	using base_t::map;
+	template<typename F> auto map(const F&) && = delete;
+	using base_t::map_cached;
+	template<typename F> auto map_cached(const F&) && = delete;
+	using base_t::map_blocks;
+	template<std::size_t N = 8, typename F> auto map_blocks(const F&) && = delete;
+	using base_t::filter;
+	template<typename Pred> auto filter(const Pred&) && = delete;
+	using base_t::stride;
+	auto stride(std::ptrdiff_t) && = delete;
+	using base_t::chunk;
+	auto chunk(std::ptrdiff_t) && = delete;
+	using base_t::zip;
+	template<typename ...Ranges> auto zip(Ranges&&...) && = delete;
+	using base_t::enumerate;
+	auto enumerate() && = delete;
+	using base_t::concat;
+	template<typename ...Ranges> auto concat(Ranges&&...) && = delete;
+	using base_t::instrument;
+	auto instrument(probe_counts&) && = delete;
+};
+
+// maps the file at path read-only and returns the range of the whole T records in it (see mmap_range).
+// throws std::system_error if the file can't be opened, inspected, or mapped.
+template<typename T>
+mmap_range<T> make_mmap_range(const char *path, const mmap_options &options = {}) { return mmap_range<T>(path, options); }
+// maps the file at path read-only and returns the range of the whole T records in it (see mmap_range).
+// throws std::system_error if the file can't be opened, inspected, or mapped.
+template<typename T>
+mmap_range<T> make_mmap_range(const std::string &path, const mmap_options &options = {}) { return mmap_range<T>(path.c_str(), options); }
+
+// the line range doesn't own the mapping, so it can't be made from a temporary mmap range (see mmap_range).
+void make_line_range(mmap_range<char>&&) = delete;
+
+#endif
 
 #endif
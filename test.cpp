@@ -1,11 +1,19 @@
 #include <iostream>
 #include <vector>
+#include <list>
+#include <array>
 #include <cassert>
 #include <numeric>
 #include <algorithm>
 #include <cmath>
 #include <iterator>
 #include <functional>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <sstream>
 
 #include "iterators++.h"
 
@@ -126,14 +134,23 @@ int main()
 	//make_func_iterator([] { return zero_int{ 345 }; })->v;
 	//make_unary_func_iterator(zero_int{0}, [](zero_int &v) {})->v;
 	//make_count_iterator(value_iterator<zero_int>(zero_int{ 234 }))->v;
-	//make_mapping_iterator(value_iterator<zero_int>(zero_int{ 14231 }), [](const zero_int &v) { return v; })->v;
-	//make_mapping_iterator(make_mapping_iterator(value_iterator<zero_int>(zero_int{ 14231 }), [](const zero_int &v) { return v; }), [](const zero_int &v) { return v; })->v;
 
 	auto map_map_1 = make_mapping_iterator(make_mapping_iterator(value_iterator<zero_int>(zero_int{ 142312 }), [](const zero_int &v) { return v; }), [](const zero_int &v) { return v; });
 	assert(map_map_1->v == 142312);
 
-	// currently can't use arrow operator on mapping iterators - ideally i'd like to fix that, but i'm not sure it's possible
-	//assert(make_mapping_iterator(value_iterator<zero_int>(zero_int{ 14231 }), [](const zero_int &v) { return v; })->v == 14231);
+	// mapping iterators return an arrow proxy holding the mapped value, so -> is also safe on temporaries
+	assert(make_mapping_iterator(value_iterator<zero_int>(zero_int{ 14231 }), [](const zero_int &v) { return v; })->v == 14231);
+	assert(make_mapping_iterator(make_mapping_iterator(value_iterator<zero_int>(zero_int{ 14231 }), [](const zero_int &v) { return v; }), [](const zero_int &v) { return v; })->v == 14231);
+	assert(make_mapping_iterator(value_iterator<zero_int>(zero_int{ 7 }), [](const zero_int &v) { return zero_int{ v.v * 3 }; })->v == 21);
+
+	const auto map_arrow_1 = make_mapping_iterator(value_iterator<int>(4), [](int v) { return zero_int{ v * v }; });
+	assert(map_arrow_1->v == 16);
+	assert(std::next(map_arrow_1)->v == 25);
+
+	// the mapped value is no longer stored in the iterator
+	struct big_value { int data[64]; bool operator==(const big_value &other) const { return data[0] == other.data[0]; } };
+	auto map_big_1 = make_mapping_iterator((int*)nullptr, [](int v) { return big_value{ { v } }; });
+	static_assert(sizeof(map_big_1) < sizeof(big_value), "mapping iterator stores its mapped value");
 
 	static_assert(std::is_same<value_iterator<char>::difference_type, signed char>::value, "traits error");
 	static_assert(std::is_same<value_iterator<unsigned short>::difference_type, short>::value, "traits error");
@@ -536,6 +553,10 @@ int main()
 
 	R_1.copy(std::ostream_iterator<int>(std::cout, " "));
 	std::cout << '\n';
+	std::ostringstream R_1_os, R_1_to;
+	R_1.copy(std::ostream_iterator<int>(R_1_os, " "));
+	R_1.copy(text_output_iterator(R_1_to, " "));
+	assert(R_1_to.str() == R_1_os.str());
 
 	auto R_2 = R_1.map([](int v) { return v / 2; });
 	assert(R_2.distance() == 25);
@@ -557,6 +578,10 @@ int main()
 
 	R_2.copy_if(std::ostream_iterator<int>(std::cout, " "), [](int v) { return v != 0; });
 	std::cout << '\n';
+	std::ostringstream R_2_os, R_2_to;
+	R_2.copy_if(std::ostream_iterator<int>(R_2_os, " "), [](int v) { return v != 0; });
+	R_2.copy_if(text_output_iterator(R_2_to, " "), [](int v) { return v != 0; });
+	assert(R_2_to.str() == R_2_os.str());
 
 	auto R_3 = make_count_range(value_iterator<int>(12), 14);
 	assert(R_3.distance() == 14);
@@ -578,8 +603,669 @@ int main()
 
 	R_3.copy(std::ostream_iterator<int>(std::cout, " "));
 	std::cout << '\n';
+	std::ostringstream R_3_os, R_3_to;
+	R_3.copy(std::ostream_iterator<int>(R_3_os, " "));
+	R_3.copy(text_output_iterator(R_3_to, " "));
+	assert(R_3_to.str() == R_3_os.str());
+
+	// stateless functions take no space in the iterators that store them
+	auto EBO_l1 = [](int v) { return v * 2; };
+	auto EBO_l2 = [](int &v) { ++v; };
+	auto EBO_l3 = [] { return 7; };
+	int EBO_capture = 3;
+	auto EBO_l4 = [EBO_capture](int v) { return v * EBO_capture; };
+	static_assert(std::is_empty<assignable_func<decltype(EBO_l1)>>::value, "EBO error");
+	static_assert(sizeof(mapping_iterator<int*, decltype(EBO_l1)>) == sizeof(int*), "EBO error");
+	static_assert(sizeof(mapping_iterator<value_iterator<int>, decltype(EBO_l1)>) == sizeof(int), "EBO error");
+	static_assert(sizeof(unary_func_iterator<int, decltype(EBO_l2)>) == sizeof(int), "EBO error");
+	static_assert(sizeof(func_iterator<decltype(EBO_l3)>) == sizeof(int), "EBO error");
+	static_assert(sizeof(mapping_iterator<int*, decltype(EBO_l4)>) == 2 * sizeof(int*), "EBO error");
+	static_assert(sizeof(mapping_iterator<int*, int(*)(int)>) == 2 * sizeof(int*), "EBO error");
+	static_assert(std::is_trivially_copy_constructible<mapping_iterator<int*, decltype(EBO_l1)>>::value, "trivial copy error");
+	static_assert(std::is_trivially_destructible<mapping_iterator<int*, decltype(EBO_l1)>>::value, "trivial copy error");
+
+	int EBO_v1[4] = { 1, 2, 3, 4 };
+	auto EBO_m1 = make_mapping_iterator(EBO_v1 + 0, EBO_l1);
+	auto EBO_m2 = make_mapping_iterator(EBO_v1 + 2, EBO_l1);
+	EBO_m1 = EBO_m2;
+	assert(*EBO_m1 == 6);
+	auto EBO_m3 = make_mapping_iterator(EBO_v1 + 0, EBO_l4);
+	EBO_m3 = make_mapping_iterator(EBO_v1 + 3, EBO_l4);
+	assert(*EBO_m3 == 12);
+
+	probe_counts P_c1, P_c2;
+	auto P_r1 = make_value_range(0, 10).instrument(P_c1).map([](int v) { return v * v; }).instrument(P_c2);
+	P_c1.reset();
+	P_c2.reset();
+	assert(P_r1.accumulate(0) == 285);
+	// exact counts depend on the stdlib's algorithms, so these only check what the pipeline guarantees
+	assert(P_c1.increments >= 10 && P_c1.derefs >= 10 && P_c1.calls == 0);
+	assert(P_c2.increments >= 10 && P_c2.derefs >= 10 && P_c2.calls == P_c2.derefs); // the map is called once per dereference
+	assert(P_c1.derefs == P_c2.derefs && P_c1.decrements == 0 && P_c2.decrements == 0);
+	assert(P_c1.copies <= 8 && P_c2.copies <= 8); // the stages aren't copied per element
+
+	P_c2.reset();
+	assert(P_r1.adjacent_find() == P_r1.end());
+	assert(P_c2.calls >= 2 * (10 - 2) && P_c2.calls == P_c2.derefs); // adjacent_find maps every interior element at least twice
+	assert(P_c2.decrements == 0);
+
+	P_c2.reset();
+	assert(P_r1.begin()[3] == 9);
+	assert(*(P_r1.begin() + 4) == 16);
+	assert(P_r1.end() - P_r1.begin() == 10);
+	assert(P_c2.derefs == 2 && P_c2.calls == 2 && P_c2.advances == 1);
+
+	std::vector<zero_int> P_v1 = { {1}, {2}, {3} };
+	probe_counts P_c3;
+	auto P_r2 = make_iterator_range(P_v1.begin(), P_v1.end()).instrument(P_c3);
+	P_c3.reset();
+	assert(P_r2.begin()->v == 1);
+	assert((--P_r2.end())->v == 3);
+	assert(P_c3.derefs == 2 && P_c3.decrements == 1);
+	assert(P_r2.begin().get_iter() == P_v1.begin());
+	assert(&P_r2.begin().get_counts() == &P_c3);
+
+	auto P_r3 = make_count_range(make_func_iterator([n = 0]()mutable{ return n++; }), 5).instrument(P_c3);
+	P_c3.reset();
+	assert(P_r3.accumulate(0) == 10);
+	assert(P_c3.increments == 5 && P_c3.derefs == 5);
+
+	static_assert(std::is_same<decltype(make_count_range(value_iterator<int>(0), 3)), iterator_range<count_iterator<value_iterator<int>>, count_sentinel>>::value, "sentinel error");
+	static_assert(sizeof(count_sentinel) == sizeof(count_sentinel::count_t), "sentinel error");
+	static_assert(std::is_same<decltype(R_3.map(EBO_l1).end()), count_sentinel>::value, "sentinel error");
+
+	auto S_r1 = make_count_range(value_iterator<int>(12), 14);
+	assert(S_r1.find(26) == S_r1.end());
+	assert(S_r1.end() - S_r1.begin() == 14);
+	assert(S_r1.begin() + 14 == S_r1.end());
+	assert(S_r1.map([](int v) { return v * 2; }).accumulate(0) == 518);
+	assert(*S_r1.map([](int v) { return v * 2; }).find(30) == 30);
+	assert(S_r1.map([](int v) { return v / 2; }).adjacent_find() != S_r1.map([](int v) { return v / 2; }).end());
+	assert(S_r1.map([](int v) { return v / 2; }).search_n(2, 7).get_iter().get_count() == 2);
+	std::vector<int> S_v1(14);
+	S_r1.copy_backward(S_v1.end());
+	assert(S_v1.front() == 12 && S_v1.back() == 25);
+	// bidirectional count ranges get a real end, so backward algorithms and walking back from end() start at the right place
+	std::list<int> S_l1 = { 1, 2, 3, 4, 5 };
+	auto S_r3 = make_count_range(S_l1.begin(), 3);
+	std::vector<int> S_v3(3);
+	S_r3.copy_backward(S_v3.end());
+	assert(S_v3 == std::vector<int>({ 1, 2, 3 }));
+	std::vector<int> S_v4(4);
+	S_r3.move_backward(S_v4.end());
+	assert(S_v4 == std::vector<int>({ 0, 1, 2, 3 }));
+	assert(*std::prev(S_r3.concat(make_count_range(std::next(S_l1.begin(), 3), 2)).end(), 3) == 3);
+
+	std::vector<int> S_v2;
+	int S_sum = 0;
+	auto S_r2 = make_count_range(make_func_iterator([n = 0]() mutable { return n += 2; }), 5);
+	assert(S_r2.accumulate(0) == 30);
+	S_r2.for_each([&](int v) { S_sum += v; });
+	assert(S_sum == 30);
+	S_r2.copy(std::back_inserter(S_v2));
+	assert(S_v2.size() == 5 && S_v2.back() == 10);
+	assert(S_r2.find(7) == S_r2.end());
+
+	int L_calls = 0;
+	auto L_gen = [&L_calls, n = 0]() mutable { ++L_calls; return n += 3; };
+	auto L_i1 = make_lazy_func_iterator(L_gen);
+	auto L_i2 = L_i1;
+	++L_i1;
+	++L_i1;
+	assert(L_calls == 0);
+	assert(*L_i1 == 9 && L_calls == 3);
+	assert(*L_i1 == 9 && L_calls == 3);
+	assert(*L_i2 == 3 && L_calls == 4);
+	L_i2 = L_i1;
+	assert(*L_i2 == 9 && L_calls == 4);
+	L_calls = 0;
+	auto L_r1 = make_count_range(make_lazy_func_iterator(L_gen), 5);
+	assert(L_calls == 0);
+	assert(L_r1.accumulate(0) == 45 && L_calls == 5);
+	assert(L_r1.distance() == 5 && L_calls == 5);
+	assert(*L_r1.find(12) == 12);
+	assert(L_r1.map([](int v) { return v / 3; }).accumulate(0) == 15);
+	auto L_s1 = make_lazy_func_iterator([n = 0]() mutable { ++n; return std::vector<int>(n, n); });
+	assert(L_s1->size() == 1);
+	assert((++L_s1)->size() == 2 && (*L_s1)[1] == 2);
+
+	struct SP_gen
+	{
+		int *copies;
+		int n = 0;
+		SP_gen(int *c) : copies(c) {}
+		SP_gen(const SP_gen &other) : copies(other.copies), n(other.n) { ++*copies; }
+		SP_gen(SP_gen &&other) = default;
+		int operator()() { return ++n; }
+	};
+	int SP_copies = 0;
+	auto SP_r1 = make_count_range(make_func_iterator(SP_gen(&SP_copies), single_pass), 4);
+	static_assert(std::is_same<std::iterator_traits<std::decay_t<decltype(SP_r1.begin())>>::iterator_category, std::input_iterator_tag>::value, "single pass error");
+	assert(SP_r1.accumulate(0) == 10);
+	auto SP_r2 = make_count_range(make_func_iterator(SP_gen(&SP_copies), single_pass), 4);
+	SP_r2.for_each([](int v) { assert(v >= 1 && v <= 4); });
+	auto SP_r3 = make_count_range(make_func_iterator(SP_gen(&SP_copies), single_pass), 4);
+	std::vector<int> SP_v1;
+	SP_r3.copy(std::back_inserter(SP_v1));
+	assert((SP_v1 == std::vector<int>{ 1, 2, 3, 4 }));
+	auto SP_r4 = make_count_range(make_func_iterator(SP_gen(&SP_copies), single_pass), 4);
+	assert(*SP_r4.find(3) == 3);
+	assert(SP_copies == 0);
+	auto SP_i1 = make_func_iterator(SP_gen(&SP_copies), single_pass);
+	auto SP_i2 = SP_i1;
+	assert(*SP_i1++ == 1 && *SP_i2 == 2);
+	assert(SP_copies == 0);
+
+	thread_pool TP_pool(3);
+	pool_policy TP_par{ &TP_pool, 16 };
+	assert(TP_pool.size() == 4);
+	auto TP_r1 = make_value_range(0, 1000);
+	assert(TP_r1.all_of(TP_par, [](int v) { return v < 1000; }));
+	assert(!TP_r1.all_of(TP_par, [](int v) { return v < 999; }));
+	assert(TP_r1.any_of(TP_par, [](int v) { return v == 777; }));
+	assert(TP_r1.none_of(TP_par, [](int v) { return v < 0; }));
+	assert(TP_r1.count(TP_par, 500) == 1);
+	assert(TP_r1.count_if(TP_par, [](int v) { return v % 3 == 0; }) == 334);
+	assert(*TP_r1.find(TP_par, 600) == 600);
+	assert(TP_r1.find(TP_par, 1000) == TP_r1.end());
+	assert(*TP_r1.find_if(TP_par, [](int v) { return v % 100 == 99; }) == 99);
+	assert(*TP_r1.find_if_not(TP_par, [](int v) { return v < 900; }) == 900);
+	assert(par_pool.min_chunk == 4096 && TP_r1.count_if(par_pool, [](int v) { return v % 2 == 0; }) == 500);
+	std::atomic<long> TP_sum(0);
+	TP_r1.for_each(TP_par, [&](int v) { TP_sum += v; });
+	assert(TP_sum == 499500);
+	probe_counts TP_c1;
+	TP_r1.instrument(TP_c1).for_each(TP_par, [&](int v) { TP_sum += v; });
+	assert(TP_sum == 2 * 499500 && TP_c1.derefs == 1000); // the counts are atomic, so no task's counts are lost
+	std::vector<int> TP_v1(1000);
+	TP_r1.map([](int v) { return v * 2; }).copy(TP_par, TP_v1.begin());
+	assert(TP_v1[0] == 0 && TP_v1[999] == 1998);
+	std::vector<int> TP_v2;
+	TP_r1.copy(TP_par, std::back_inserter(TP_v2));
+	assert(TP_v2.size() == 1000 && TP_v2[999] == 999);
+	make_iterator_range(TP_v1.begin(), TP_v1.end()).fill(TP_par, 7);
+	assert(std::count(TP_v1.begin(), TP_v1.end(), 7) == 1000);
+	auto TP_r2 = make_iterator_range(TP_v2.data(), TP_v2.data() + TP_v2.size()).map([](int v) { return v / 10; });
+	assert(TP_r2.find(TP_par, 42) - TP_r2.begin() == 420);
+	assert(make_count_range(value_iterator<int>(0), 1000).count_if(TP_par, [](int v) { return v >= 990; }) == 10);
+	assert(TP_r1.count_if(TP_par, [&](int) { return TP_r1.count_if(TP_par, [](int v) { return v < 2; }) == 2; }) == 1000);
+	bool TP_threw = false;
+	try { TP_r1.for_each(TP_par, [](int v) { if (v == 321) throw v; }); }
+	catch (int v) { TP_threw = v == 321; }
+	assert(TP_threw);
+
+	thread_pool RD_pool1(1), RD_pool0(0);
+	auto RD_r1 = make_value_range(0, 100000).map([](int v) { return 1.0 / (v + 1); });
+	double RD_d1 = RD_r1.reduce(0.0);
+	assert(RD_d1 == RD_r1.reduce(TP_par, 0.0));
+	assert(RD_d1 == RD_r1.reduce(pool_policy{ &RD_pool1, 1 }, 0.0));
+	assert(RD_d1 == RD_r1.reduce(pool_policy{ &RD_pool0 }, 0.0));
+	assert(RD_d1 == RD_r1.reduce(par_pool, 0.0, std::plus<>{}));
+	assert(std::abs(RD_d1 - RD_r1.accumulate(0.0)) < 1e-9);
+	auto RD_r2 = make_count_range(make_func_iterator([n = 0]() mutable { return 1.0 / ++n; }), 100000);
+	assert(RD_d1 == RD_r2.reduce(0.0));
+	assert(RD_d1 == RD_r2.reduce(TP_par, 0.0));
+	assert(make_value_range(0, 1000).reduce(0) == 499500);
+	assert(make_value_range(0, 1000).reduce(TP_par, 0) == 499500);
+	assert(make_value_range(1, 11).reduce(1, std::multiplies<>{}) == 3628800);
+	assert(make_value_range(1, 11).reduce(TP_par, 1, std::multiplies<>{}) == 3628800);
+	assert(make_value_range(0, 0).reduce(TP_par, 5) == 5);
+	assert(make_value_range(0, 1000).transform_reduce(0L, std::plus<>{}, [](int v) { return (long)v * v; }) == 332833500L);
+	assert(make_value_range(0, 1000).transform_reduce(TP_par, 0L, std::plus<>{}, [](int v) { return (long)v * v; }) == 332833500L);
+	assert(make_count_range(value_iterator<int>(0), 1000).reduce(TP_par, 0) == 499500);
+
+	static_assert(is_integral_value_range<value_iterator<int>, value_iterator<int>>::value, "closed form error");
+	static_assert(!is_integral_value_range<value_iterator<double>, value_iterator<double>>::value, "closed form error");
+	static_assert(!is_integral_value_range<count_iterator<value_iterator<int>>, count_sentinel>::value, "closed form error");
+	auto CF_r1 = make_value_range(-5, 5);
+	assert(CF_r1.accumulate(0) == -5);
+	assert(CF_r1.accumulate(100L) == 95);
+	assert(CF_r1.reduce(0) == -5 && CF_r1.reduce(TP_par, 0) == -5);
+	assert(CF_r1.count(-5) == 1 && CF_r1.count(4) == 1 && CF_r1.count(5) == 0 && CF_r1.count(-6) == 0);
+	assert(CF_r1.count(4u) == 1 && CF_r1.count(-1L) == 1);
+	assert(CF_r1.find(3) - CF_r1.begin() == 8);
+	assert(CF_r1.find(5) == CF_r1.end());
+	assert(CF_r1.adjacent_find() == CF_r1.end());
+	assert(CF_r1.search_n(1, 2) == CF_r1.find(2) && CF_r1.search_n(2, 2) == CF_r1.end() && CF_r1.search_n(0, 2) == CF_r1.begin());
+	assert(make_value_range(5, 5).accumulate(7) == 7 && make_value_range(5, 5).find(5) == make_value_range(5, 5).end());
+	auto CF_r2 = make_value_range(0u, 10u);
+	assert(CF_r2.count(-1) == 0 && CF_r2.count(9) == 1);
+	auto CF_r3 = make_value_range<std::int64_t>(-1000000000, 3000000000);
+	assert(CF_r3.accumulate(std::int64_t(0)) == 3999999998000000000);
+	assert(*CF_r3.find(2999999999LL) == 2999999999LL && CF_r3.count(3000000000LL) == 0);
+	auto CF_r4 = make_value_range<std::uint64_t>(0, 10000000000);
+	assert(CF_r4.accumulate(std::uint64_t(0)) == (std::uint64_t)13106511847580896768ull); // wraps like the serial loop
+	assert(CF_r4.accumulate(0u) == (unsigned)CF_r4.accumulate(std::uint64_t(0)));
+	auto CF_r5 = make_value_range<unsigned char>(200, 255);
+	assert(CF_r5.accumulate((unsigned char)3) == std::accumulate(CF_r5.begin(), CF_r5.end(), (unsigned char)3));
+	assert(CF_r5.accumulate(0) == std::accumulate(CF_r5.begin(), CF_r5.end(), 0));
+	assert(CF_r5.count(300) == 0 && CF_r5.count(254) == 1);
+	// values are matched with == (in the common type, like std::find and std::count), not by mathematical value
+	assert(CF_r1.count(4294967295u) == std::count(CF_r1.begin(), CF_r1.end(), 4294967295u) && CF_r1.count(4294967295u) == 1);
+	assert(CF_r1.find(4294967292u) == std::find(CF_r1.begin(), CF_r1.end(), 4294967292u) && *CF_r1.find(4294967292u) == -4);
+	auto CF_r6 = make_value_range(4294967290u, 4294967295u);
+	assert(CF_r6.find(-6) == std::find(CF_r6.begin(), CF_r6.end(), -6) && CF_r6.find(-6) == CF_r6.begin() && CF_r6.count(-1) == 0);
+	assert(CF_r5.count(-56) == std::count(CF_r5.begin(), CF_r5.end(), -56) && CF_r5.count((signed char)-56) == 0);
+	assert(make_value_range<std::int64_t>(-3, 3).count(18446744073709551615ull) == 1 && make_value_range<short>(-3, 3).count(4294967295u) == 1);
+
+	auto BM_block = [](const std::array<int, 4> &in) { std::array<long, 4> out; for (int i = 0; i < 4; ++i) out[i] = in[i] * 3L; return out; };
+	auto BM_r1 = make_value_range(0, 10).map_blocks<4>(BM_block);
+	static_assert(is_block_mapping_iterator<std::decay_t<decltype(BM_r1.begin())>>::value, "block map error");
+	static_assert(sizeof(BM_r1.begin()) == sizeof(int), "block map error");
+	assert(BM_r1.accumulate(0L) == 135);
+	assert(BM_r1.accumulate(1L, std::multiplies<>{}) == 0);
+	assert(*BM_r1.begin() == 0 && BM_r1.begin()[9] == 27);
+	assert(BM_r1.distance() == 10);
+	std::vector<long> BM_v1;
+	BM_r1.copy(std::back_inserter(BM_v1));
+	assert(BM_v1.size() == 10 && BM_v1[3] == 9 && BM_v1[9] == 27);
+	long BM_sum = 0;
+	BM_r1.for_each([&](long v) { BM_sum += v; });
+	assert(BM_sum == 135);
+	unsigned BM_a1[13];
+	for (unsigned i = 0; i < 13; ++i) BM_a1[i] = i + 1;
+	auto BM_r2 = make_iterator_range(BM_a1 + 0, BM_a1 + 13).map_blocks([](unsigned v) { return v * v; });
+	assert(BM_r2.accumulate(0u) == 819);
+	assert(make_iterator_range(BM_a1 + 0, BM_a1 + 0).map_blocks([](unsigned v) { return v * v; }).accumulate(5u) == 5);
+	assert(make_count_range(value_iterator<int>(1), 13).map_blocks<4>([](int v) { return v * v; }).accumulate(0) == 819);
+	assert(make_count_range(make_func_iterator([n = 0]() mutable { return ++n; }), 13).map_blocks<4>([](int v) { return v * v; }).accumulate(0) == 819);
+	// dereferencing an elementwise block mapping calls the function once, not once per lane
+	int BM_calls = 0;
+	auto BM_r3 = make_value_range(0, 10).map_blocks<4>([&BM_calls](int v) { ++BM_calls; return v * 3; });
+	assert(*BM_r3.begin() == 0 && BM_calls == 1);
+	BM_calls = 0;
+	assert(*BM_r3.find_if([](int v) { return v == 15; }) == 15 && BM_calls == 6 + 1);
+	BM_calls = 0;
+	assert(BM_r3.accumulate(0) == 135 && BM_calls == 12); // whole blocks - the last one is padded
+	// a real block function maps a whole block for each dereference
+	int BM_blocks = 0;
+	auto BM_r4 = make_value_range(0, 10).map_blocks<4>([&BM_blocks, BM_block](const std::array<int, 4> &in) { ++BM_blocks; return BM_block(in); });
+	assert(*BM_r4.begin() == 0 && BM_r4.begin()[9] == 27 && BM_blocks == 2);
+	// a block mapping over a map isn't fused into it, so it is still processed a block at a time
+	BM_blocks = 0;
+	auto BM_r5 = make_value_range(0, 16).map([](int v) { return v + 1; }).map_blocks<4>([&BM_blocks, BM_block](const std::array<int, 4> &in) { ++BM_blocks; return BM_block(in); });
+	static_assert(is_block_mapping_iterator<std::decay_t<decltype(BM_r5.begin())>>::value, "block map error");
+	assert(BM_r5.accumulate(0L) == 3 * 136 && BM_blocks == 4);
+
+	auto MF_f = [](int v) { return v + 1; };
+	auto MF_g = [](int v) { return v * 2L; };
+	auto MF_h = [](long v) { return (double)v / 4; };
+	auto MF_r1 = make_value_range(0, 10).map(MF_f).map(MF_g).map(MF_h);
+	static_assert(std::is_same<std::decay_t<decltype(MF_r1.begin())>, mapping_iterator<value_iterator<int>, composed_func<decltype(MF_f), decltype(MF_g), decltype(MF_h)>>>::value, "map fusion error");
+	static_assert(sizeof(MF_r1.begin()) == sizeof(value_iterator<int>), "map fusion error");
+	assert(*MF_r1.begin() == 0.5 && MF_r1.begin()[9] == 5.0);
+	assert(MF_r1.accumulate(0.0) == 27.5);
+	int MF_k = 3;
+	auto MF_times = [MF_k](int v) { return v * MF_k; };
+	auto MF_r2 = make_count_range(value_iterator<int>(0), 5).map(MF_f).map(MF_times);
+	static_assert(std::is_same<std::decay_t<decltype(MF_r2.end())>, count_sentinel>::value, "map fusion error");
+	static_assert(sizeof(MF_r2.begin()) == sizeof(mapping_iterator<count_iterator<value_iterator<int>>, decltype(MF_times)>), "map fusion error");
+	assert(MF_r2.accumulate(0) == 45);
+	auto MF_r3 = make_value_range(0, 10).map_blocks<4>(BM_block).map([](long v) { return v + 1; });
+	static_assert(is_block_mapping_iterator<std::decay_t<decltype(MF_r3.begin().get_iter())>>::value, "map fusion error");
+	assert(MF_r3.accumulate(0L) == 145);
+
+	int FL_calls = 0;
+	auto FL_even = [&FL_calls](int v) { ++FL_calls; return v % 2 == 0; };
+	std::vector<int> FL_v1 = { 1, 2, 3, 4, 5, 6, 7, 9 };
+	auto FL_r1 = make_iterator_range(FL_v1.begin(), FL_v1.end()).filter(FL_even);
+	static_assert(std::is_same<std::decay_t<decltype(FL_r1.begin())>::iterator_category, std::bidirectional_iterator_tag>::value, "filter error");
+	static_assert(std::is_same<std::decay_t<decltype(FL_r1.begin())>, std::decay_t<decltype(FL_r1.end())>>::value, "filter error");
+	assert(FL_calls == 2); // the first match is found when the range is created
+	assert(*FL_r1.begin() == 2 && *FL_r1.begin() == 2 && FL_calls == 2); // dereferencing does no predicate work
+	std::vector<int> FL_v2;
+	FL_r1.copy(std::back_inserter(FL_v2));
+	assert((FL_v2 == std::vector<int>{ 2, 4, 6 }));
+	assert(FL_calls == 8); // the copy checked each element after the first match once
+	assert(FL_r1.distance() == 3 && FL_r1.accumulate(0) == 12 && FL_r1.count(4) == 1);
+	assert(*std::prev(FL_r1.end()) == 6 && *std::prev(FL_r1.end(), 3) == 2);
+	*FL_r1.begin() = 10;
+	assert(FL_v1[1] == 10);
+	assert(make_iterator_range(FL_v1.begin(), FL_v1.end()).filter([](int v) { return v > 100; }).distance() == 0);
+	auto FL_r2 = make_count_range(value_iterator<int>(0), 20).filter([](int v) { return v % 3 == 0; });
+	static_assert(std::is_same<std::decay_t<decltype(FL_r2.end())>, filter_sentinel>::value, "filter error");
+	assert(FL_r2.accumulate(0) == 63 && FL_r2.distance() == 7);
+	assert(*FL_r2.find(9) == 9 && FL_r2.find(10) == FL_r2.end());
+	auto FL_r3 = FL_r2.map([](int v) { return v * 2; });
+	static_assert(std::is_same<std::decay_t<decltype(FL_r3.end())>, filter_sentinel>::value, "filter error");
+	assert(FL_r3.accumulate(0) == 126 && FL_r3.count(12) == 1);
+	assert(make_value_range(0, 10).map([](int v) { return v * v; }).filter([](int v) { return v % 2 == 1; }).accumulate(0) == 165);
+	assert(make_value_range(0, 10).filter([](int v) { return v % 2 == 1; }).filter([](int v) { return v > 4; }).accumulate(0) == 21);
+	auto FL_r4 = make_count_range(make_func_iterator([n = 0]() mutable { return ++n; }, single_pass), 10).filter([](int v) { return v > 7; });
+	static_assert(std::is_same<std::decay_t<decltype(FL_r4.begin())>::iterator_category, std::input_iterator_tag>::value, "filter error");
+	assert(FL_r4.accumulate(0) == 27);
+
+	int CM_calls = 0;
+	auto CM_sq = [&CM_calls](int v) { ++CM_calls; return v * v; };
+	std::vector<int> CM_v1 = { 1, 2, 3, 4, 5, 5, 6 };
+	auto CM_r1 = make_iterator_range(CM_v1.begin(), CM_v1.end()).map_cached(CM_sq);
+	static_assert(std::is_same<std::decay_t<decltype(CM_r1.begin())>::iterator_category, std::random_access_iterator_tag>::value, "cached map error");
+	static_assert(std::is_same<decltype(*CM_r1.begin()), int>::value, "cached map error");
+	assert(CM_r1.adjacent_find() - CM_r1.begin() == 4);
+	assert(CM_calls == 6); // once per position visited
+	CM_calls = 0;
+	assert(make_iterator_range(CM_v1.begin(), CM_v1.end()).map(CM_sq).adjacent_find().get_iter() - CM_v1.begin() == 4);
+	assert(CM_calls == 10); // twice per comparison
+	CM_calls = 0;
+	auto CM_i1 = CM_r1.begin() + 2;
+	assert(*CM_i1 == 9 && *CM_i1 == 9 && CM_calls == 1);
+	auto CM_i2 = CM_i1;
+	assert(*CM_i2 == 9 && CM_calls == 1); // copies carry the cache
+	assert(*++CM_i2 == 16 && *--CM_i2 == 9 && CM_calls == 3); // moving drops it
+	assert(CM_i1[4] == 36 && CM_r1.end() - CM_i1 == 5 && CM_i1 < CM_r1.end());
+	CM_calls = 0;
+	assert(CM_r1.search_n(2, 25) - CM_r1.begin() == 4 && CM_calls == 6);
+	assert(CM_r1.accumulate(0) == 116);
+	auto CM_r2 = make_count_range(value_iterator<int>(1), 5).map_cached([](int v) { return zero_int{ v * 3 }; });
+	static_assert(std::is_same<std::decay_t<decltype(CM_r2.end())>, count_sentinel>::value, "cached map error");
+	auto CM_i3 = std::next(CM_r2.begin(), 4);
+	assert(CM_r2.begin()->v == 3 && CM_i3->v == 15);
+	assert(CM_r2.find_if([](const zero_int &z) { return z.v == 9; }) - CM_r2.begin() == 2);
+	// dereferencing gives a copy of the cache, so values outlive the iterator that produced them (e.g. a reverse iterator's temporary)
+	auto CM_r3 = make_value_range(0, 4).map_cached([](int v) { return std::string(32, (char)('a' + v)); });
+	std::reverse_iterator<std::decay_t<decltype(CM_r3.begin())>> CM_ri(CM_r3.end());
+	assert(*CM_ri == std::string(32, 'd') && CM_ri->size() == 32 && *std::next(CM_ri, 3) == std::string(32, 'a'));
+	auto CM_i4 = CM_r3.begin();
+	const std::string CM_s1 = *CM_i4;
+	auto CM_i5 = CM_i4;
+	++CM_i4;
+	assert(*CM_i5 == CM_s1 && *CM_i4 == std::string(32, 'b'));
+
+	int ST_m[3][4] = { { 1, 2, 3, 4 }, { 5, 6, 7, 8 }, { 9, 10, 11, 12 } }; // row-major
+	auto ST_col = make_iterator_range(&ST_m[0][1], &ST_m[0][0] + 12).stride(4);
+	static_assert(std::is_same<std::decay_t<decltype(ST_col.begin())>::iterator_category, std::random_access_iterator_tag>::value, "stride error");
+	assert(ST_col.distance() == 3 && ST_col.end() - ST_col.begin() == 3 && ST_col.accumulate(0) == 18);
+	assert(ST_col.begin()[2] == 10 && *(ST_col.end() - 1) == 10 && *std::prev(ST_col.end(), 3) == 2);
+	assert(ST_col.end().get_iter() == &ST_m[0][0] + 12); // the end step is cut short rather than overshooting
+	*std::lower_bound(ST_col.begin(), ST_col.end(), 6) = 60;
+	assert(ST_m[1][1] == 60);
+	auto ST_r1 = make_value_range(0, 10).stride(3);
+	assert(ST_r1.distance() == 4 && *(ST_r1.begin() + 3) == 9 && ST_r1.begin() + 4 == ST_r1.end());
+	assert(ST_r1.end() - (ST_r1.begin() + 1) == 3 && (ST_r1.end() - 2) - ST_r1.begin() == 2);
+	assert(ST_r1.count_if(TP_par, [](int v) { return v % 2 == 0; }) == 2);
+	assert(make_value_range(0, 10).stride(5).distance() == 2 && make_value_range(0, 10).stride(20).distance() == 1 && make_value_range(0, 0).stride(3).distance() == 0);
+	auto ST_r2 = make_count_range(value_iterator<int>(0), 10).stride(3);
+	static_assert(std::is_same<decltype(ST_r2.begin()), decltype(ST_r2.end())>::value, "stride error");
+	assert(ST_r2.accumulate(0) == 18 && ST_r2.distance() == 4 && *std::prev(ST_r2.end()) == 9);
+	auto ST_r3 = make_count_range(make_func_iterator([n = 0]() mutable { return n++; }), 10).stride(4);
+	static_assert(std::is_same<std::decay_t<decltype(ST_r3.begin())>::iterator_category, std::forward_iterator_tag>::value, "stride error");
+	assert(ST_r3.accumulate(0) == 12 && ST_r3.distance() == 3);
+	assert(make_value_range(0, 20).map([](int v) { return v * v; }).stride(6).accumulate(0) == 0 + 36 + 144 + 324);
+
+	std::vector<int> ZP_ids = { 4, 8, 15, 16, 23, 42 };
+	std::vector<long> ZP_ts = { 100, 200, 300, 400, 500, 600, 700 }; // longer than ids
+	std::vector<double> ZP_vals(6);
+	auto ZP_r1 = make_iterator_range(ZP_ids.begin(), ZP_ids.end()).zip(ZP_ts, ZP_vals);
+	static_assert(std::is_same<std::decay_t<decltype(ZP_r1.begin())>::iterator_category, std::random_access_iterator_tag>::value, "zip error");
+	static_assert(std::is_same<std::decay_t<decltype(ZP_r1.begin())>::reference, std::tuple<int&, long&, double&>>::value, "zip error");
+	assert(ZP_r1.distance() == 6 && ZP_r1.end() - ZP_r1.begin() == 6);
+	ZP_r1.for_each([](std::tuple<int&, long&, double&> t) { std::get<2>(t) = std::get<0>(t) + std::get<1>(t) / 100.0; });
+	assert(ZP_vals[0] == 5 && ZP_vals[5] == 48);
+	assert(std::get<1>(*std::prev(ZP_r1.end())) == 600 && std::get<1>(ZP_r1.begin()[2]) == 300);
+	assert(ZP_r1.map([](std::tuple<int&, long&, double&> t) { return std::get<0>(t) * std::get<1>(t); }).accumulate(0L) == 4 * 100 + 8 * 200 + 15 * 300 + 16 * 400 + 23 * 500 + 42 * 600);
+	assert(std::get<1>(*ZP_r1.find_if([](std::tuple<int&, long&, double&> t) { return std::get<0>(t) > 15; })) == 400);
+	auto ZP_r2 = make_count_range(value_iterator<int>(0), 4).zip(ZP_ids, make_value_range(10, 20));
+	static_assert(std::is_same<std::decay_t<decltype(ZP_r2.end())>, count_sentinel>::value, "zip error");
+	assert(ZP_r2.distance() == 4 && ZP_r2.count_if([](std::tuple<const int&, int&, const int&> t) { return std::get<1>(t) % 2 == 0; }) == 3);
+	assert(ZP_r2.accumulate(0, [](int a, std::tuple<const int&, int&, const int&> t) { return a + std::get<0>(t) * std::get<2>(t); }) == 0 * 10 + 1 * 11 + 2 * 12 + 3 * 13);
+	std::list<int> ZP_l = { 1, 2, 3, 4, 5, 6 };
+	auto ZP_r3 = make_iterator_range(ZP_l.begin(), ZP_l.end()).zip(ZP_ids);
+	static_assert(std::is_same<std::decay_t<decltype(ZP_r3.begin())>::iterator_category, std::bidirectional_iterator_tag>::value, "zip error");
+	assert(std::get<1>(*std::prev(ZP_r3.end())) == 42 && std::get<0>(*std::prev(ZP_r3.end())) == 6);
+	// walking back from the end stays aligned when the other ranges are longer
+	std::list<int> ZP_l3 = { 1, 2, 3 };
+	std::list<int> ZP_l5 = { 10, 20, 30, 40, 50 };
+	auto ZP_r4 = make_iterator_range(ZP_l3.begin(), ZP_l3.end()).zip(ZP_l5);
+	assert(*std::prev(ZP_r4.end()) == std::make_tuple(3, 30) && *std::prev(ZP_r4.end(), 3) == std::make_tuple(1, 10));
+	assert(*std::prev(make_iterator_range(ZP_l3.begin(), ZP_l3.end()).zip(ZP_ts).end()) == std::make_tuple(3, 300L));
+
+	int EN_a[5] = { 10, 20, 30, 40, 50 };
+	auto EN_r1 = make_iterator_range(EN_a + 0, EN_a + 5).enumerate();
+	typedef std::decay_t<decltype(EN_r1.begin())> EN_iter_t;
+	static_assert(std::is_same<EN_iter_t::iterator_category, std::random_access_iterator_tag>::value, "enumerate error");
+	static_assert(std::is_same<EN_iter_t::reference, std::pair<std::ptrdiff_t, int&>>::value, "enumerate error");
+	static_assert(std::is_same<EN_iter_t, std::decay_t<decltype(EN_r1.end())>>::value, "enumerate error");
+	assert(EN_r1.distance() == 5 && EN_r1.end() - EN_r1.begin() == 5 && std::prev(EN_r1.end())->first == 4);
+	assert(EN_r1.begin()[3].first == 3 && EN_r1.begin()[3].second == 40);
+	assert(EN_r1.find_if([](std::pair<std::ptrdiff_t, int&> p) { return p.second == 30; })->first == 2);
+	EN_r1.for_each([](std::pair<std::ptrdiff_t, int&> p) { p.second += (int)p.first; });
+	assert(EN_a[0] == 10 && EN_a[4] == 54);
+	auto EN_r2 = make_value_range(5, 10).enumerate();
+	assert(EN_r2.accumulate(0L, [](long a, std::pair<std::ptrdiff_t, const int&> p) { return a + p.first * p.second; }) == 0 * 5 + 1 * 6 + 2 * 7 + 3 * 8 + 4 * 9);
+	auto EN_r3 = make_count_range(make_func_iterator([n = 0]() mutable { return n += 3; }), 4).enumerate();
+	static_assert(std::is_same<std::decay_t<decltype(EN_r3.end())>, count_sentinel>::value, "enumerate error");
+	static_assert(sizeof(EN_r3.begin()) == sizeof(EN_r3.begin().get_iter()), "enumerate error"); // no counter of its own
+	assert(EN_r3.distance() == 4 && EN_r3.accumulate(0, [](int a, auto p) { return a + (int)p.first * p.second; }) == 0 * 3 + 1 * 6 + 2 * 9 + 3 * 12);
+	std::list<int> EN_l = { 7, 8, 9 };
+	auto EN_r4 = make_iterator_range(EN_l.begin(), EN_l.end()).enumerate();
+	static_assert(std::is_same<std::decay_t<decltype(EN_r4.end())>, iterator_sentinel<std::list<int>::iterator>>::value, "enumerate error");
+	assert(EN_r4.distance() == 3 && EN_r4.find_if([](auto p) { return p.second == 9; })->first == 2);
+	assert(make_iterator_range(EN_a + 0, EN_a + 5).filter([](int v) { return v > 30; }).enumerate().count_if([](auto p) { return p.first == 1; }) == 1);
+
+	int CH_a[10] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	auto CH_r1 = make_iterator_range(CH_a + 0, CH_a + 10).chunk(4);
+	typedef std::decay_t<decltype(CH_r1.begin())> CH_iter_t;
+	static_assert(std::is_same<CH_iter_t::iterator_category, std::random_access_iterator_tag>::value, "chunk error");
+	static_assert(std::is_same<CH_iter_t::value_type, iterator_range<int*, int*>>::value, "chunk error");
+	assert(CH_r1.distance() == 3 && CH_r1.end() - CH_r1.begin() == 3);
+	assert((*CH_r1.begin()).begin() == CH_a && (*CH_r1.begin()).end() == CH_a + 4);
+	assert(CH_r1.begin()[1].begin() == CH_a + 4 && std::prev(CH_r1.end())->distance() == 2 && std::prev(CH_r1.end())->end() == CH_a + 10);
+	assert(CH_r1.map([](iterator_range<int*, int*> c) { return c.accumulate(0); }).accumulate(0) == 55);
+	assert(CH_r1.count_if(TP_par, [](iterator_range<int*, int*> c) { return c.distance() == 4; }) == 2);
+	CH_r1.for_each([](iterator_range<int*, int*> c) { c.fill(*c.begin()); });
+	assert(CH_a[3] == 1 && CH_a[4] == 5 && CH_a[9] == 9);
+	assert(make_iterator_range(CH_a + 0, CH_a + 8).chunk(4).distance() == 2 && make_iterator_range(CH_a + 0, CH_a + 0).chunk(4).distance() == 0);
+	auto CH_r2 = make_value_range(0, 7).chunk(3);
+	assert(CH_r2.distance() == 3 && (CH_r2.begin() + 2)->accumulate(0) == 6);
+	auto CH_r3 = make_count_range(make_func_iterator([n = 0]() mutable { return ++n; }), 7).chunk(3);
+	static_assert(std::is_same<std::decay_t<decltype(CH_r3.begin())>::iterator_category, std::forward_iterator_tag>::value, "chunk error");
+	std::vector<int> CH_v1;
+	CH_r3.for_each([&](auto c) { CH_v1.push_back(c.accumulate(0)); });
+	assert((CH_v1 == std::vector<int>{ 6, 15, 7 }));
+
+	std::vector<int> CC_v1 = { 1, 2, 3 }, CC_v2, CC_v3 = { 4, 5 };
+	auto CC_r1 = make_iterator_range(CC_v1.begin(), CC_v1.end()).concat(CC_v2, CC_v3);
+	typedef std::decay_t<decltype(CC_r1.begin())> CC_iter_t;
+	static_assert(std::is_same<CC_iter_t, concat_iterator<std::vector<int>::iterator, 3>>::value, "concat error");
+	static_assert(std::is_same<CC_iter_t::iterator_category, std::random_access_iterator_tag>::value, "concat error");
+	assert(CC_r1.distance() == 5 && CC_r1.end() - CC_r1.begin() == 5 && CC_r1.accumulate(0) == 15);
+	assert(CC_r1.begin()[3] == 4 && *(CC_r1.end() - 1) == 5 && *std::prev(CC_r1.end(), 3) == 3 && (CC_r1.begin() + 4) - (CC_r1.begin() + 1) == 3);
+	assert(CC_r1.find(4) - CC_r1.begin() == 3 && CC_r1.find(4).get_segment() == 2 && CC_r1.find(9) == CC_r1.end());
+	assert(CC_r1.find_if([](int v) { return v > 1; }) == CC_r1.begin() + 1 && CC_r1.count_if([](int v) { return v % 2 != 0; }) == 3 && CC_r1.count(5) == 1);
+	assert(CC_r1.for_each([n = 0](int v) mutable { n = n * 10 + v; return n; })(0) == 12345 * 10);
+	int CC_a[5] = {};
+	CC_r1.copy(CC_a + 0);
+	assert(CC_a[0] == 1 && CC_a[2] == 3 && CC_a[3] == 4 && CC_a[4] == 5);
+	assert(CC_r1.map([](int v) { return v * v; }).accumulate(0) == 55 && std::max_element(CC_r1.begin(), CC_r1.end()) - CC_r1.begin() == 4);
+	std::reverse(CC_r1.begin(), CC_r1.end());
+	assert((CC_v1 == std::vector<int>{ 5, 4, 3 }) && (CC_v3 == std::vector<int>{ 2, 1 }));
+	std::sort(CC_r1.begin(), CC_r1.end());
+	assert((CC_v1 == std::vector<int>{ 1, 2, 3 }) && (CC_v3 == std::vector<int>{ 4, 5 }));
+	auto CC_r2 = make_iterator_range(CC_a + 0, CC_a + 0).concat(make_iterator_range(CC_a + 1, CC_a + 3), make_iterator_range(CC_a + 3, CC_a + 3));
+	assert(*CC_r2.begin() == 2 && CC_r2.distance() == 2 && CC_r2.accumulate(0) == 5 && CC_r2.find(3) == CC_r2.begin() + 1);
+	assert(make_iterator_range(CC_a + 0, CC_a + 0).concat().distance() == 0 && make_iterator_range(CC_a + 0, CC_a + 2).concat(make_iterator_range(CC_a + 0, CC_a + 2)).accumulate(0) == 6);
+	std::list<int> CC_l1 = { 1, 2 }, CC_l2 = { 3 };
+	auto CC_r3 = make_iterator_range(CC_l1.begin(), CC_l1.end()).concat(CC_l2);
+	static_assert(std::is_same<std::decay_t<decltype(CC_r3.begin())>::iterator_category, std::bidirectional_iterator_tag>::value, "concat error");
+	assert(CC_r3.distance() == 3 && *std::prev(CC_r3.end()) == 3 && *std::prev(CC_r3.end(), 2) == 2 && CC_r3.accumulate(0) == 6);
+	auto CC_r4 = make_count_range(value_iterator<int>(0), 3).concat(make_count_range(value_iterator<int>(10), 2));
+	assert(CC_r4.distance() == 5 && CC_r4.accumulate(0) == 0 + 1 + 2 + 10 + 11);
+
+#ifdef DRAGAZO_ITERATORS_PLUS_PLUS_POSIX
+	struct MM_rec { std::uint32_t id; float value; };
+	const char *const MM_path = "iterators-test-mmap.bin";
+	{
+		std::FILE *f = std::fopen(MM_path, "wb");
+		assert(f);
+		for (std::uint32_t i = 0; i < 1000; ++i) { MM_rec r = { i, i * 0.5f }; std::fwrite(&r, sizeof(r), 1, f); }
+		std::fputc('x', f); // a trailing partial record
+		std::fclose(f);
+	}
+	{
+		auto MM_r1 = make_mmap_range<MM_rec>(MM_path);
+		static_assert(std::is_base_of<iterator_range<const MM_rec*, const MM_rec*>, decltype(MM_r1)>::value, "mmap error");
+		assert(MM_r1.distance() == 1000 && MM_r1.begin()[10].id == 10 && std::prev(MM_r1.end())->value == 999 * 0.5f);
+		assert(MM_r1.map([](const MM_rec &r) { return (std::uint64_t)r.id; }).accumulate(std::uint64_t(0)) == 999 * 1000 / 2);
+		assert(MM_r1.count_if([](const MM_rec &r) { return r.value >= 250; }) == 500);
+		auto MM_r2 = MM_r1; // copies share the mapping
+		assert(MM_r2.begin() == MM_r1.begin() && MM_r2.get_mapping().use_count() == 2);
+		mmap_options MM_opts;
+		MM_opts.populate = MM_opts.hugepages = true;
+		MM_opts.sequential = false;
+		assert(make_mmap_range<std::uint8_t>(std::string(MM_path), MM_opts).distance() == 1000 * sizeof(MM_rec) + 1);
+		assert(MM_r1.stride(100).map([](const MM_rec &r) { return r.id; }).accumulate(0u) == 4500);
+		// adapted ranges don't own the mapping, so they can't be made from a temporary mmap range
+		auto MM_id = [](const MM_rec &r) { return r.id; };
+		auto MM_map = [MM_id](auto &&r) -> decltype(std::forward<decltype(r)>(r).map(MM_id)) { return std::forward<decltype(r)>(r).map(MM_id); };
+		auto MM_stride = [](auto &&r) -> decltype(std::forward<decltype(r)>(r).stride(2)) { return std::forward<decltype(r)>(r).stride(2); };
+		auto MM_enumerate = [](auto &&r) -> decltype(std::forward<decltype(r)>(r).enumerate()) { return std::forward<decltype(r)>(r).enumerate(); };
+		static_assert(std::is_invocable<decltype(MM_map), mmap_range<MM_rec>&>::value && !std::is_invocable<decltype(MM_map), mmap_range<MM_rec>>::value, "mmap error");
+		static_assert(std::is_invocable<decltype(MM_stride), mmap_range<MM_rec>&>::value && !std::is_invocable<decltype(MM_stride), mmap_range<MM_rec>>::value, "mmap error");
+		static_assert(std::is_invocable<decltype(MM_enumerate), mmap_range<MM_rec>&>::value && !std::is_invocable<decltype(MM_enumerate), mmap_range<MM_rec>>::value, "mmap error");
+		static_assert(std::is_invocable<decltype(MM_map), iterator_range<const MM_rec*, const MM_rec*>>::value, "mmap error");
+	}
+	std::fclose(std::fopen(MM_path, "wb"));
+	assert(make_mmap_range<MM_rec>(MM_path).distance() == 0 && !make_mmap_range<MM_rec>(MM_path).get_mapping());
+	std::remove(MM_path);
+	bool MM_threw = false;
+	try { make_mmap_range<MM_rec>(MM_path); }
+	catch (const std::system_error &e) { MM_threw = e.code().value() == ENOENT; }
+	assert(MM_threw);
+#endif
+
+	auto LN_r1 = make_line_range("a\r\nbb\n\nccc");
+	static_assert(std::is_same<std::decay_t<decltype(*LN_r1.begin())>, std::string_view>::value, "line error");
+	assert(LN_r1.distance() == 4 && *LN_r1.begin() == "a" && *std::next(LN_r1.begin()) == "bb" && std::next(LN_r1.begin(), 2)->empty() && *std::next(LN_r1.begin(), 3) == "ccc");
+	assert(LN_r1.map([](std::string_view l) { return l.size(); }).accumulate(std::size_t(0)) == 6);
+	assert(LN_r1.count_if([](std::string_view l) { return l.empty(); }) == 1 && *LN_r1.find_if([](std::string_view l) { return l.size() > 2; }) == "ccc");
+	assert(make_line_range("").distance() == 0 && make_line_range("\n").distance() == 1 && make_line_range("x\n").distance() == 1 && make_line_range("\r\n\r\n").count_if([](std::string_view l) { return l.empty(); }) == 2);
+	std::string LN_s = "first line\nsecond\r\n";
+	auto LN_r2 = make_line_range(LN_s);
+	assert(LN_r2.distance() == 2 && (*LN_r2.begin()).data() == LN_s.data() && *std::next(LN_r2.begin()) == "second");
+	assert(make_line_range(make_iterator_range(LN_s.c_str() + 6, LN_s.c_str() + LN_s.size())).begin()->size() == 4);
+#ifdef DRAGAZO_ITERATORS_PLUS_PLUS_POSIX
+	{
+		std::FILE *f = std::fopen(MM_path, "wb");
+		assert(f);
+		std::fputs("id,value\r\n1,10\r\n2,20\r\n3,30", f);
+		std::fclose(f);
+		auto LN_file = make_mmap_range<char>(MM_path);
+		assert(make_line_range(LN_file).map([](std::string_view l) { return l.size(); }).accumulate(std::size_t(0)) == 8 + 4 * 3);
+		std::remove(MM_path);
+	}
+#endif
+
+	struct BR_rec { std::uint16_t id; std::uint8_t flag; };
+	std::stringstream BR_ss1;
+	for (std::uint16_t i = 0; i < 100; ++i) { BR_rec r = { i, (std::uint8_t)(i % 3 == 0) }; BR_ss1.write(reinterpret_cast<const char*>(&r), sizeof(r)); }
+	BR_ss1.write("xy", 2); // a trailing partial record
+	auto BR_r1 = make_binary_read_range<BR_rec>(BR_ss1, 7); // small blocks, so records are refilled many times
+	static_assert(std::is_same<std::decay_t<decltype(BR_r1.begin())>::iterator_category, std::input_iterator_tag>::value, "binary read error");
+	assert(BR_r1.map([](const BR_rec &r) { return (int)r.id; }).accumulate(0) == 99 * 100 / 2);
+	assert(BR_r1.begin() == BR_r1.end() && BR_r1.distance() == 0);
+	BR_ss1.clear();
+	BR_ss1.seekg(0);
+	assert(make_binary_read_range<BR_rec>(BR_ss1).count_if([](const BR_rec &r) { return r.flag != 0; }) == 34);
+	BR_ss1.clear();
+	BR_ss1.seekg(0);
+	binary_read_iterator<BR_rec> BR_i1(BR_ss1, 4);
+	assert((*BR_i1++).id == 0 && BR_i1->id == 1);
+	assert(make_count_range(BR_i1, 10).map([](const BR_rec &r) { return (int)r.id; }).accumulate(0) == 1 + 2 + 3 + 4 + 5 + 6 + 7 + 8 + 9 + 10 && BR_i1->id == 11);
+	// reading a known count leaves the stream just past those records, even with a larger block size
+	BR_ss1.clear();
+	BR_ss1.seekg(0);
+	assert(make_binary_read_range_n<BR_rec>(BR_ss1, 10).map([](const BR_rec &r) { return (int)r.id; }).accumulate(0) == 9 * 10 / 2);
+	assert(make_binary_read_range_n<BR_rec>(BR_ss1, 3, 2).distance() == 3);
+	assert(make_binary_read_range_n<BR_rec>(BR_ss1, 1).begin()->id == 13 && (std::size_t)BR_ss1.tellg() == 14 * sizeof(BR_rec));
+	BR_ss1.clear();
+	BR_ss1.seekg(98 * sizeof(BR_rec));
+	assert(make_binary_read_range_n<BR_rec>(BR_ss1, 10).distance() == 2 && make_binary_read_range_n<BR_rec>(BR_ss1, 0).distance() == 0);
+	std::stringstream BR_ss2;
+	assert(make_binary_read_range<int>(BR_ss2).distance() == 0 && binary_read_iterator<int>() == binary_read_iterator<int>());
+#ifdef DRAGAZO_ITERATORS_PLUS_PLUS_POSIX
+	{
+		std::FILE *f = std::fopen(MM_path, "wb");
+		assert(f);
+		for (std::uint32_t i = 0; i < 5000; ++i) std::fwrite(&i, sizeof(i), 1, f);
+		std::fclose(f);
+		const int fd = ::open(MM_path, O_RDONLY);
+		assert(fd >= 0);
+		std::vector<std::uint32_t> BR_v1;
+		auto BR_n = *make_binary_read_range_n<std::uint32_t>(fd, 1).begin(); // e.g. a header count
+		make_binary_read_range<std::uint32_t>(fd, 1000).copy(std::back_inserter(BR_v1));
+		::close(fd);
+		assert(BR_n == 0 && BR_v1.size() == 4999 && BR_v1[0] == 1 && BR_v1[4998] == 4999);
+		std::remove(MM_path);
+		bool BR_threw = false;
+		try { binary_read_iterator<int> BR_i2(-1); }
+		catch (const std::system_error &e) { BR_threw = e.code().value() == EBADF; }
+		assert(BR_threw);
+	}
+#endif
+
+	std::ostringstream TO_ss1;
+	make_value_range(1, 6).copy(text_output_iterator(TO_ss1, " "));
+	assert(TO_ss1.str() == "1 2 3 4 5 ");
+	TO_ss1.str("");
+	{
+		text_output_iterator TO_i1(TO_ss1, ",");
+		*TO_i1++ = -12; *TO_i1++ = 0.5; *TO_i1++ = 2.5f; *TO_i1++ = true; *TO_i1++ = 'c'; *TO_i1++ = std::uint64_t(18446744073709551615ull); *TO_i1++ = "str";
+		assert(TO_ss1.str().empty()); // nothing is written until a flush
+		TO_i1.flush();
+		assert(TO_ss1.str() == "-12,0.5,2.5,1,c,18446744073709551615,str,");
+	}
+	TO_ss1.str("");
+	make_value_range(0, 10000).copy(text_output_iterator(TO_ss1, "\n", 1)); // a tiny buffer, so it's flushed many times
+	const std::string TO_s1 = TO_ss1.str();
+	assert(make_line_range(TO_s1).distance() == 10000 && *std::next(make_line_range(TO_s1).begin(), 9999) == "9999");
+	// the narrow character types are written as characters, as std::ostream_iterator does - wide ones aren't accepted
+	{
+		const std::uint8_t TO_u8s[] = { 'a', 'b', 'c' };
+		std::ostringstream TO_os, TO_to;
+		std::copy(TO_u8s, TO_u8s + 3, std::ostream_iterator<std::uint8_t>(TO_os, ","));
+		std::copy(TO_u8s, TO_u8s + 3, text_output_iterator(TO_to, ","));
+		*text_output_iterator(TO_to, ",") = (signed char)'s';
+		assert(TO_to.str() == TO_os.str() + "s," && TO_os.str() == "a,b,c,");
+		auto TO_assign = [](auto v) -> decltype(text_output_iterator(std::cout) = v) { return text_output_iterator(std::cout) = v; };
+		static_assert(std::is_invocable<decltype(TO_assign), unsigned char>::value && std::is_invocable<decltype(TO_assign), long double>::value, "text output error");
+		static_assert(!std::is_invocable<decltype(TO_assign), wchar_t>::value && !std::is_invocable<decltype(TO_assign), char16_t>::value && !std::is_invocable<decltype(TO_assign), char32_t>::value, "text output error");
+	}
+	std::ostringstream TO_ss2;
+	make_line_range("a\r\nbb\nccc").map([](std::string_view l) { return l.substr(0, 2); }).copy(text_output_iterator(TO_ss2, "|"));
+	assert(TO_ss2.str() == "a|bb|cc|");
+#ifdef DRAGAZO_ITERATORS_PLUS_PLUS_POSIX
+	{
+		const int fd = ::open(MM_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		assert(fd >= 0);
+		make_value_range(0, 1000).copy(text_output_iterator(fd, " "));
+		::close(fd);
+		std::vector<int> TO_v1;
+		std::FILE *f = std::fopen(MM_path, "rb");
+		assert(f);
+		for (int v; std::fscanf(f, "%d", &v) == 1; ) TO_v1.push_back(v);
+		std::fclose(f);
+		std::remove(MM_path);
+		assert(TO_v1.size() == 1000 && TO_v1[999] == 999);
+	}
+#endif
+
+	auto FD_r1 = make_field_range("a,b,,\"c,d\",\"e\"\"f\"");
+	static_assert(std::is_same<std::decay_t<decltype(*FD_r1.begin())>, std::string_view>::value, "field error");
+	std::vector<std::string_view> FD_v1;
+	FD_r1.copy(std::back_inserter(FD_v1));
+	assert((FD_v1 == std::vector<std::string_view>{ "a", "b", "", "c,d", "e\"\"f" }));
+	assert(make_field_range("").distance() == 1 && make_field_range("a,").distance() == 2 && make_field_range(",").distance() == 2 && make_field_range("x").distance() == 1);
+	assert(*std::next(make_field_range("\"ab,c").begin(), 0) == "ab,c" && make_field_range("\"ab,c").distance() == 1); // unterminated quote
+	assert(*std::next(make_field_range("\"a\"x,b").begin()) == "b" && *make_field_range("\"a\"x,b").begin() == "a"); // junk after a closing quote
+	assert(make_field_range("1\t2\t'3\t4'", '\t', '\'').map([](std::string_view f) { return f.size(); }).accumulate(std::size_t(0)) == 5);
+	auto FD_r2 = make_line_range("id,name\r\n1,\"x,y\"\n2,z").map(field_splitter{});
+	assert(FD_r2.map([](iterator_range<field_iterator> r) { return r.distance(); }).accumulate(std::ptrdiff_t(0)) == 6);
+	assert(*std::next(std::next(FD_r2.begin())->begin()) == "x,y" && *std::next(FD_r2.begin(), 2)->begin() == "2");
+	assert(FD_r2.count_if([](iterator_range<field_iterator> r) { return r.find("z") != r.end(); }) == 1);
 
 	std::cout << "\n\nall tests completed" << std::endl;
+#ifndef ITERATORS_TEST_NO_PAUSE
 	std::cin.get();
+#endif
 	return 0;
 }